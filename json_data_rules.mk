@@ -1,8 +1,17 @@
 # JSON files are run through jsonproc, which is a tool that converts JSON data to an output file
 # based on an Inja template. https://github.com/pantor/inja
 
+# jsonproc only rewrites wild_encounters.h when its contents change, so it
+# hangs off a stamp like the map data. The stamp is dropped when the header
+# is missing.
+WILD_ENCOUNTERS_STAMP := $(C_BUILDDIR)/wild_encounters.stamp
+
+$(if $(wildcard $(DATA_SRC_SUBDIR)/wild_encounters.h),,$(shell rm -f $(WILD_ENCOUNTERS_STAMP)))
+
 AUTO_GEN_TARGETS += $(DATA_SRC_SUBDIR)/wild_encounters.h
-$(DATA_SRC_SUBDIR)/wild_encounters.h: $(DATA_SRC_SUBDIR)/wild_encounters.json $(DATA_SRC_SUBDIR)/wild_encounters.json.txt
-	$(JSONPROC) $^ $@
+$(WILD_ENCOUNTERS_STAMP): $(DATA_SRC_SUBDIR)/wild_encounters.json $(DATA_SRC_SUBDIR)/wild_encounters.json.txt
+	$(JSONPROC) $^ $(DATA_SRC_SUBDIR)/wild_encounters.h
+	@touch $@
+$(DATA_SRC_SUBDIR)/wild_encounters.h: $(WILD_ENCOUNTERS_STAMP) ;
 
 $(C_BUILDDIR)/wild_encounter.o: c_dep += $(DATA_SRC_SUBDIR)/wild_encounters.h
@@ -13,19 +13,54 @@ $(DATA_ASM_BUILDDIR)/maps.o: $(DATA_ASM_SUBDIR)/maps.s $(LAYOUTS_DIR)/layouts.in
 $(DATA_ASM_BUILDDIR)/map_events.o: $(DATA_ASM_SUBDIR)/map_events.s $(MAPS_DIR)/events.inc $(MAP_EVENTS)
 	$(PREPROC) $< charmap.txt | $(CPP) -I include - | $(AS) $(ASFLAGS) -o $@
 
+MAP_JSONS := $(addsuffix map.json,$(MAP_DIRS))
+
+# mapjson doesn't touch outputs whose contents are unchanged, so they hang off
+# stamps in the build directory. Whatever is built from them is only rebuilt
+# when they really change. A stamp is dropped when any of its outputs is
+# missing, so they all get regenerated.
+MAP_STAMP := $(DATA_ASM_BUILDDIR)/maps.stamp
+MAP_GROUPS_STAMP := $(DATA_ASM_BUILDDIR)/map_groups.stamp
+LAYOUTS_STAMP := $(DATA_ASM_BUILDDIR)/layouts.stamp
+MAP_CACHE := $(DATA_ASM_BUILDDIR)/maps.cache
+
+MAP_OUTPUTS := $(MAP_HEADERS) $(MAP_EVENTS) $(MAP_CONNECTIONS)
+MAP_GROUPS_OUTPUTS := $(MAPS_DIR)/groups.inc $(MAPS_DIR)/connections.inc $(MAPS_DIR)/events.inc $(MAPS_DIR)/headers.inc include/constants/map_groups.h
+LAYOUTS_OUTPUTS := $(LAYOUTS_DIR)/layouts.inc $(LAYOUTS_DIR)/layouts_table.inc include/constants/layouts.h
+
+$(if $(filter-out $(wildcard $(MAP_OUTPUTS)),$(MAP_OUTPUTS)),$(shell rm -f $(MAP_STAMP)))
+$(if $(filter-out $(wildcard $(MAP_GROUPS_OUTPUTS)),$(MAP_GROUPS_OUTPUTS)),$(shell rm -f $(MAP_GROUPS_STAMP)))
+$(if $(filter-out $(wildcard $(LAYOUTS_OUTPUTS)),$(LAYOUTS_OUTPUTS)),$(shell rm -f $(LAYOUTS_STAMP)))
+
+ifneq ($(MAP_BATCH),0)
+# All changed maps are processed by a single mapjson run, which reads
+# layouts.json once. Build with MAP_BATCH=0 to run mapjson once per map instead.
+# The run also records each map's id, layout and connections in MAP_CACHE, so
+# groups mode can get the map ids without parsing every map.json again.
+$(MAP_STAMP): $(MAP_JSONS)
+	@echo "$(MAPJSON) maps emerald $(LAYOUTS_DIR)/layouts.json --cache $(MAP_CACHE) <$(words $?) maps>"
+	@$(MAPJSON) maps emerald $(LAYOUTS_DIR)/layouts.json --cache $(MAP_CACHE) $?
+	@touch $@
+$(MAP_OUTPUTS): $(MAP_STAMP) ;
+
+# Rerun after the maps change too, since map_groups.h holds their ids.
+$(MAP_GROUPS_STAMP): $(MAPS_DIR)/map_groups.json $(MAP_STAMP)
+	$(MAPJSON) groups emerald $< --cache $(MAP_CACHE)
+	@touch $@
+else
 $(MAPS_DIR)/%/header.inc: $(MAPS_DIR)/%/map.json
 	$(MAPJSON) map emerald $< $(LAYOUTS_DIR)/layouts.json
 $(MAPS_DIR)/%/events.inc: $(MAPS_DIR)/%/header.inc ;
 $(MAPS_DIR)/%/connections.inc: $(MAPS_DIR)/%/events.inc ;
 
-$(MAPS_DIR)/groups.inc: $(MAPS_DIR)/map_groups.json
+$(MAP_GROUPS_STAMP): $(MAPS_DIR)/map_groups.json
 	$(MAPJSON) groups emerald $<
-$(MAPS_DIR)/connections.inc: $(MAPS_DIR)/groups.inc ;
-$(MAPS_DIR)/events.inc: $(MAPS_DIR)/connections.inc ;
-$(MAPS_DIR)/headers.inc: $(MAPS_DIR)/events.inc ;
-include/constants/map_groups.h: $(MAPS_DIR)/headers.inc ;
+	@touch $@
+endif
+
+$(MAP_GROUPS_OUTPUTS): $(MAP_GROUPS_STAMP) ;
 
-$(LAYOUTS_DIR)/layouts.inc: $(LAYOUTS_DIR)/layouts.json
+$(LAYOUTS_STAMP): $(LAYOUTS_DIR)/layouts.json
 	$(MAPJSON) layouts emerald $<
-$(LAYOUTS_DIR)/layouts_table.inc: $(LAYOUTS_DIR)/layouts.inc ;
-include/constants/layouts.h: $(LAYOUTS_DIR)/layouts_table.inc ;
+	@touch $@
+$(LAYOUTS_OUTPUTS): $(LAYOUTS_STAMP) ;
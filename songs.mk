@@ -1,1264 +1,450 @@
 STD_REVERB = 50
 
+# The mid2agb options for each song, by the song's file name.
+MID_OPTIONS_mus_aqua_magma_hideout = -E -R$(STD_REVERB) -G076 -V084
+MID_OPTIONS_mus_encounter_aqua = -E -R$(STD_REVERB) -G065 -V086
+MID_OPTIONS_mus_route111 = -E -R$(STD_REVERB) -G055 -V076
+MID_OPTIONS_mus_encounter_suspicious = -E -R$(STD_REVERB) -G069 -V078
+MID_OPTIONS_mus_b_arena = -E -R$(STD_REVERB) -G104 -V090
+MID_OPTIONS_mus_b_dome = -E -R$(STD_REVERB) -G111 -V090
+MID_OPTIONS_mus_b_dome_lobby = -E -R$(STD_REVERB) -G111 -V056
+MID_OPTIONS_mus_b_factory = -E -R$(STD_REVERB) -G113 -V100
+MID_OPTIONS_mus_b_frontier = -E -R$(STD_REVERB) -G103 -V094
+MID_OPTIONS_mus_b_palace = -E -R$(STD_REVERB) -G108 -V105
+MID_OPTIONS_mus_b_tower_rs = -E -R$(STD_REVERB) -G035 -V080
+MID_OPTIONS_mus_b_pike = -E -R$(STD_REVERB) -G112 -V092
+MID_OPTIONS_mus_vs_trainer = -E -R$(STD_REVERB) -G119 -V080 -P1
+MID_OPTIONS_mus_vs_wild = -E -R$(STD_REVERB) -G117 -V080 -P1
+MID_OPTIONS_mus_vs_aqua_magma_leader = -E -R$(STD_REVERB) -G126 -V080 -P1
+MID_OPTIONS_mus_vs_aqua_magma = -E -R$(STD_REVERB) -G118 -V080 -P1
+MID_OPTIONS_mus_vs_gym_leader = -E -R$(STD_REVERB) -G120 -V080 -P1
+MID_OPTIONS_mus_vs_champion = -E -R$(STD_REVERB) -G121 -V080 -P1
+MID_OPTIONS_mus_vs_kyogre_groudon = -E -R$(STD_REVERB) -G123 -V080 -P1
+MID_OPTIONS_mus_vs_rival = -E -R$(STD_REVERB) -G124 -V080 -P1
+MID_OPTIONS_mus_vs_regi = -E -R$(STD_REVERB) -G122 -V080 -P1
+MID_OPTIONS_mus_vs_elite_four = -E -R$(STD_REVERB) -G125 -V080 -P1
+MID_OPTIONS_mus_roulette = -E -R$(STD_REVERB) -G038 -V080
+MID_OPTIONS_mus_lilycove_museum = -E -R$(STD_REVERB) -G020 -V080
+MID_OPTIONS_mus_encounter_brendan = -E -R$(STD_REVERB) -G067 -V078
+MID_OPTIONS_mus_encounter_male = -E -R$(STD_REVERB) -G028 -V080
+MID_OPTIONS_mus_victory_road = -E -R$(STD_REVERB) -G075 -V076
+MID_OPTIONS_mus_game_corner = -E -R$(STD_REVERB) -G072 -V072
+MID_OPTIONS_mus_contest_winner = -E -R$(STD_REVERB) -G085 -V100
+MID_OPTIONS_mus_contest_results = -E -R$(STD_REVERB) -G092 -V080
+MID_OPTIONS_mus_contest_lobby = -E -R$(STD_REVERB) -G098 -V060
+MID_OPTIONS_mus_contest = -E -R$(STD_REVERB) -G086 -V088
+MID_OPTIONS_mus_cycling = -E -R$(STD_REVERB) -G049 -V083
+MID_OPTIONS_mus_encounter_champion = -E -R$(STD_REVERB) -G100 -V076
+MID_OPTIONS_mus_petalburg_woods = -E -R$(STD_REVERB) -G018 -V080
+MID_OPTIONS_mus_abandoned_ship = -E -R$(STD_REVERB) -G030 -V080
+MID_OPTIONS_mus_cave_of_origin = -E -R$(STD_REVERB) -G037 -V080
+MID_OPTIONS_mus_underwater = -E -R$(STD_REVERB) -G057 -V094
+MID_OPTIONS_mus_intro = -E -R$(STD_REVERB) -G060 -V090
+MID_OPTIONS_mus_hall_of_fame = -E -R$(STD_REVERB) -G082 -V078
+MID_OPTIONS_mus_route110 = -E -R$(STD_REVERB) -G010 -V080
+MID_OPTIONS_mus_route120 = -E -R$(STD_REVERB) -G014 -V080
+MID_OPTIONS_mus_route122 = -E -R$(STD_REVERB) -G021 -V080
+MID_OPTIONS_mus_route101 = -E -R$(STD_REVERB) -G011 -V080
+MID_OPTIONS_mus_dummy = -E -R40
+MID_OPTIONS_mus_hall_of_fame_room = -E -R$(STD_REVERB) -G093 -V080
+MID_OPTIONS_mus_end = -E -R$(STD_REVERB) -G102 -V036
+MID_OPTIONS_mus_help = -E -R$(STD_REVERB) -G056 -V078
+MID_OPTIONS_mus_level_up = -E -R$(STD_REVERB) -G012 -V090 -P5
+MID_OPTIONS_mus_obtain_item = -E -R$(STD_REVERB) -G012 -V090 -P5
+MID_OPTIONS_mus_evolved = -E -R$(STD_REVERB) -G012 -V090 -P5
+MID_OPTIONS_mus_gsc_route38 = -E -R$(STD_REVERB) -V080
+MID_OPTIONS_mus_slateport = -E -R$(STD_REVERB) -G079 -V070
+MID_OPTIONS_mus_poke_mart = -E -R$(STD_REVERB) -G050 -V085
+MID_OPTIONS_mus_oceanic_museum = -E -R$(STD_REVERB) -G023 -V080
+MID_OPTIONS_mus_gym = -E -R$(STD_REVERB) -G013 -V080
+MID_OPTIONS_mus_encounter_may = -E -R$(STD_REVERB) -G061 -V078
+MID_OPTIONS_mus_encounter_female = -E -R$(STD_REVERB) -G053 -V072
+MID_OPTIONS_mus_verdanturf = -E -R$(STD_REVERB) -G044 -V090
+MID_OPTIONS_mus_rustboro = -E -R$(STD_REVERB) -G045 -V085
+MID_OPTIONS_mus_route119 = -E -R$(STD_REVERB) -G048 -V096
+MID_OPTIONS_mus_encounter_intense = -E -R$(STD_REVERB) -G062 -V078
+MID_OPTIONS_mus_weather_groudon = -E -R$(STD_REVERB) -G090 -V050
+MID_OPTIONS_mus_dewford = -E -R$(STD_REVERB) -G073 -V078
+MID_OPTIONS_mus_encounter_twins = -E -R$(STD_REVERB) -G095 -V075
+MID_OPTIONS_mus_encounter_interviewer = -E -R$(STD_REVERB) -G099 -V062
+MID_OPTIONS_mus_victory_trainer = -E -R$(STD_REVERB) -G058 -V091
+MID_OPTIONS_mus_victory_wild = -E -R$(STD_REVERB) -G025 -V080
+MID_OPTIONS_mus_victory_gym_leader = -E -R$(STD_REVERB) -G024 -V080
+MID_OPTIONS_mus_victory_aqua_magma = -E -R$(STD_REVERB) -G070 -V088
+MID_OPTIONS_mus_victory_league = -E -R$(STD_REVERB) -G029 -V080
+MID_OPTIONS_mus_caught = -E -R$(STD_REVERB) -G025 -V080
+MID_OPTIONS_mus_encounter_cool = -E -R$(STD_REVERB) -G063 -V086
+MID_OPTIONS_mus_trick_house = -E -R$(STD_REVERB) -G094 -V070
+MID_OPTIONS_mus_route113 = -E -R$(STD_REVERB) -G064 -V084
+MID_OPTIONS_mus_sailing = -E -R$(STD_REVERB) -G077 -V086
+MID_OPTIONS_mus_mt_pyre = -E -R$(STD_REVERB) -G078 -V088
+MID_OPTIONS_mus_sealed_chamber = -E -R$(STD_REVERB) -G084 -V100
+MID_OPTIONS_mus_petalburg = -E -R$(STD_REVERB) -G015 -V080
+MID_OPTIONS_mus_fortree = -E -R$(STD_REVERB) -G032 -V080
+MID_OPTIONS_mus_oldale = -E -R$(STD_REVERB) -G019 -V080
+MID_OPTIONS_mus_mt_pyre_exterior = -E -R$(STD_REVERB) -G080 -V080
+MID_OPTIONS_mus_heal = -E -R$(STD_REVERB) -G012 -V090 -P5
+MID_OPTIONS_mus_slots_jackpot = -E -R$(STD_REVERB) -G012 -V090 -P5
+MID_OPTIONS_mus_slots_win = -E -R$(STD_REVERB) -G012 -V090 -P5
+MID_OPTIONS_mus_obtain_badge = -E -R$(STD_REVERB) -G012 -V090 -P5
+MID_OPTIONS_mus_obtain_berry = -E -R$(STD_REVERB) -G012 -V090 -P5
+MID_OPTIONS_mus_obtain_b_points = -E -R$(STD_REVERB) -G103 -V090 -P5
+MID_OPTIONS_mus_rg_photo = -E -R$(STD_REVERB) -G180 -V100 -P5
+MID_OPTIONS_mus_evolution_intro = -E -R$(STD_REVERB) -G026 -V080
+MID_OPTIONS_mus_obtain_symbol = -E -R$(STD_REVERB) -G103 -V100 -P5
+MID_OPTIONS_mus_awaken_legend = -E -R$(STD_REVERB) -G012 -V090 -P5
+MID_OPTIONS_mus_register_match_call = -E -R$(STD_REVERB) -G105 -V090 -P5
+MID_OPTIONS_mus_move_deleted = -E -R$(STD_REVERB) -G012 -V090 -P5
+MID_OPTIONS_mus_obtain_tmhm = -E -R$(STD_REVERB) -G012 -V090 -P5
+MID_OPTIONS_mus_too_bad = -E -R$(STD_REVERB) -G012 -V090 -P5
+MID_OPTIONS_mus_encounter_magma = -E -R$(STD_REVERB) -G087 -V072
+MID_OPTIONS_mus_lilycove = -E -R$(STD_REVERB) -G054 -V085
+MID_OPTIONS_mus_littleroot = -E -R$(STD_REVERB) -G051 -V100
+MID_OPTIONS_mus_surf = -E -R$(STD_REVERB) -G017 -V080
+MID_OPTIONS_mus_route104 = -E -R$(STD_REVERB) -G047 -V097
+MID_OPTIONS_mus_gsc_pewter = -E -R$(STD_REVERB) -V080
+MID_OPTIONS_mus_birch_lab = -E -R$(STD_REVERB) -G033 -V080
+MID_OPTIONS_mus_abnormal_weather = -E -R$(STD_REVERB) -G089 -V080
+MID_OPTIONS_mus_school = -E -R$(STD_REVERB) -G081 -V100
+MID_OPTIONS_mus_c_comm_center = -E -R$(STD_REVERB) -V080
+MID_OPTIONS_mus_poke_center = -E -R$(STD_REVERB) -G046 -V092
+MID_OPTIONS_mus_b_pyramid = -E -R$(STD_REVERB) -G106 -V079
+MID_OPTIONS_mus_b_pyramid_top = -E -R$(STD_REVERB) -G107 -V077
+MID_OPTIONS_mus_ever_grande = -E -R$(STD_REVERB) -G068 -V086
+MID_OPTIONS_mus_rayquaza_appears = -E -R$(STD_REVERB) -G109 -V090
+MID_OPTIONS_mus_rg_rocket_hideout = -E -R$(STD_REVERB) -G133 -V090
+MID_OPTIONS_mus_rg_follow_me = -E -R$(STD_REVERB) -G131 -V068
+MID_OPTIONS_mus_rg_victory_road = -E -R$(STD_REVERB) -G154 -V090
+MID_OPTIONS_mus_rg_cycling = -E -R$(STD_REVERB) -G141 -V090
+MID_OPTIONS_mus_rg_intro_fight = -E -R$(STD_REVERB) -G136 -V090
+MID_OPTIONS_mus_rg_hall_of_fame = -E -R$(STD_REVERB) -G145 -V079
+MID_OPTIONS_mus_rg_encounter_deoxys = -E -R$(STD_REVERB) -G184 -V079
+MID_OPTIONS_mus_rg_credits = -E -R$(STD_REVERB) -G149 -V090
+MID_OPTIONS_mus_rg_encounter_gym_leader = -E -R$(STD_REVERB) -G144 -V090
+MID_OPTIONS_mus_rg_dex_rating = -E -R$(STD_REVERB) -G175 -V070 -P5
+MID_OPTIONS_mus_rg_obtain_key_item = -E -R$(STD_REVERB) -G178 -V077 -P5
+MID_OPTIONS_mus_rg_caught_intro = -E -R$(STD_REVERB) -G179 -V094 -P5
+MID_OPTIONS_mus_rg_caught = -E -R$(STD_REVERB) -G170 -V100
+MID_OPTIONS_mus_rg_cinnabar = -E -R$(STD_REVERB) -G138 -V090
+MID_OPTIONS_mus_rg_gym = -E -R$(STD_REVERB) -G134 -V090
+MID_OPTIONS_mus_rg_fuchsia = -E -R$(STD_REVERB) -G167 -V090
+MID_OPTIONS_mus_rg_poke_jump = -E -R$(STD_REVERB) -G132 -V090
+MID_OPTIONS_mus_rg_heal = -E -R$(STD_REVERB) -G140 -V090
+MID_OPTIONS_mus_rg_oak_lab = -E -R$(STD_REVERB) -G160 -V075
+MID_OPTIONS_mus_rg_berry_pick = -E -R$(STD_REVERB) -G132 -V090
+MID_OPTIONS_mus_rg_vermillion = -E -R$(STD_REVERB) -G172 -V090
+MID_OPTIONS_mus_rg_route1 = -E -R$(STD_REVERB) -G150 -V079
+MID_OPTIONS_mus_rg_route3 = -E -R$(STD_REVERB) -G152 -V083
+MID_OPTIONS_mus_rg_route11 = -E -R$(STD_REVERB) -G153 -V090
+MID_OPTIONS_mus_rg_pallet = -E -R$(STD_REVERB) -G159 -V100
+MID_OPTIONS_mus_rg_surf = -E -R$(STD_REVERB) -G164 -V071
+MID_OPTIONS_mus_rg_sevii_45 = -E -R$(STD_REVERB) -G188 -V084
+MID_OPTIONS_mus_rg_sevii_67 = -E -R$(STD_REVERB) -G189 -V084
+MID_OPTIONS_mus_rg_sevii_123 = -E -R$(STD_REVERB) -G173 -V084
+MID_OPTIONS_mus_rg_sevii_cave = -E -R$(STD_REVERB) -G147 -V090
+MID_OPTIONS_mus_rg_sevii_dungeon = -E -R$(STD_REVERB) -G146 -V090
+MID_OPTIONS_mus_rg_sevii_route = -E -R$(STD_REVERB) -G187 -V080
+MID_OPTIONS_mus_rg_net_center = -E -R$(STD_REVERB) -G162 -V096
+MID_OPTIONS_mus_rg_pewter = -E -R$(STD_REVERB) -G173 -V084
+MID_OPTIONS_mus_rg_oak = -E -R$(STD_REVERB) -G161 -V086
+MID_OPTIONS_mus_rg_mystery_gift = -E -R$(STD_REVERB) -G183 -V100
+MID_OPTIONS_mus_rg_route24 = -E -R$(STD_REVERB) -G151 -V086
+MID_OPTIONS_mus_rg_teachy_tv_show = -E -R$(STD_REVERB) -G131 -V068
+MID_OPTIONS_mus_rg_mt_moon = -E -R$(STD_REVERB) -G147 -V090
+MID_OPTIONS_mus_rg_poke_tower = -E -R$(STD_REVERB) -G165 -V090
+MID_OPTIONS_mus_rg_poke_center = -E -R$(STD_REVERB) -G162 -V096
+MID_OPTIONS_mus_rg_poke_flute = -E -R$(STD_REVERB) -G165 -V048 -P5
+MID_OPTIONS_mus_rg_poke_mansion = -E -R$(STD_REVERB) -G148 -V090
+MID_OPTIONS_mus_rg_jigglypuff = -E -R$(STD_REVERB) -G135 -V068 -P5
+MID_OPTIONS_mus_rg_encounter_rival = -E -R$(STD_REVERB) -G174 -V079
+MID_OPTIONS_mus_rg_rival_exit = -E -R$(STD_REVERB) -G174 -V079
+MID_OPTIONS_mus_rg_encounter_rocket = -E -R$(STD_REVERB) -G142 -V096
+MID_OPTIONS_mus_rg_ss_anne = -E -R$(STD_REVERB) -G163 -V090
+MID_OPTIONS_mus_rg_new_game_exit = -E -R$(STD_REVERB) -G182 -V088
+MID_OPTIONS_mus_rg_new_game_intro = -E -R$(STD_REVERB) -G182 -V088
+MID_OPTIONS_mus_rg_lavender = -E -R$(STD_REVERB) -G139 -V090
+MID_OPTIONS_mus_rg_silph = -E -R$(STD_REVERB) -G166 -V076
+MID_OPTIONS_mus_rg_encounter_girl = -E -R$(STD_REVERB) -G143 -V051
+MID_OPTIONS_mus_rg_encounter_boy = -E -R$(STD_REVERB) -G144 -V090
+MID_OPTIONS_mus_rg_game_corner = -E -R$(STD_REVERB) -G132 -V090
+MID_OPTIONS_mus_rg_slow_pallet = -E -R$(STD_REVERB) -G159 -V092
+MID_OPTIONS_mus_rg_new_game_instruct = -E -R$(STD_REVERB) -G182 -V085
+MID_OPTIONS_mus_rg_viridian_forest = -E -R$(STD_REVERB) -G146 -V090
+MID_OPTIONS_mus_rg_trainer_tower = -E -R$(STD_REVERB) -G134 -V090
+MID_OPTIONS_mus_rg_celadon = -E -R$(STD_REVERB) -G168 -V070
+MID_OPTIONS_mus_rg_title = -E -R$(STD_REVERB) -G137 -V090
+MID_OPTIONS_mus_rg_game_freak = -E -R$(STD_REVERB) -G181 -V075
+MID_OPTIONS_mus_rg_teachy_tv_menu = -E -R$(STD_REVERB) -G186 -V059
+MID_OPTIONS_mus_rg_union_room = -E -R$(STD_REVERB) -G132 -V090
+MID_OPTIONS_mus_rg_vs_legend = -E -R$(STD_REVERB) -G157 -V090
+MID_OPTIONS_mus_rg_vs_deoxys = -E -R$(STD_REVERB) -G185 -V080
+MID_OPTIONS_mus_rg_vs_gym_leader = -E -R$(STD_REVERB) -G155 -V090
+MID_OPTIONS_mus_rg_vs_champion = -E -R$(STD_REVERB) -G158 -V090
+MID_OPTIONS_mus_rg_vs_mewtwo = -E -R$(STD_REVERB) -G157 -V090
+MID_OPTIONS_mus_rg_vs_trainer = -E -R$(STD_REVERB) -G156 -V090
+MID_OPTIONS_mus_rg_vs_wild = -E -R$(STD_REVERB) -G157 -V090
+MID_OPTIONS_mus_rg_victory_gym_leader = -E -R$(STD_REVERB) -G171 -V090
+MID_OPTIONS_mus_rg_victory_trainer = -E -R$(STD_REVERB) -G169 -V089
+MID_OPTIONS_mus_rg_victory_wild = -E -R$(STD_REVERB) -G170 -V090
+MID_OPTIONS_mus_cable_car = -E -R$(STD_REVERB) -G071 -V078
+MID_OPTIONS_mus_sootopolis = -E -R$(STD_REVERB) -G091 -V062
+MID_OPTIONS_mus_safari_zone = -E -R$(STD_REVERB) -G074 -V082
+MID_OPTIONS_mus_b_tower = -E -R$(STD_REVERB) -G110 -V100
+MID_OPTIONS_mus_evolution = -E -R$(STD_REVERB) -G026 -V080
+MID_OPTIONS_mus_encounter_elite_four = -E -R$(STD_REVERB) -G096 -V078
+MID_OPTIONS_mus_c_vs_legend_beast = -E -R$(STD_REVERB) -V080
+MID_OPTIONS_mus_encounter_swimmer = -E -R$(STD_REVERB) -G036 -V080
+MID_OPTIONS_mus_encounter_girl = -E -R$(STD_REVERB) -G027 -V080
+MID_OPTIONS_mus_intro_battle = -E -R$(STD_REVERB) -G088 -V088
+MID_OPTIONS_mus_encounter_rich = -E -R$(STD_REVERB) -G043 -V094
+MID_OPTIONS_mus_link_contest_p1 = -E -R$(STD_REVERB) -G039 -V079
+MID_OPTIONS_mus_link_contest_p2 = -E -R$(STD_REVERB) -G040 -V090
+MID_OPTIONS_mus_link_contest_p3 = -E -R$(STD_REVERB) -G041 -V075
+MID_OPTIONS_mus_link_contest_p4 = -E -R$(STD_REVERB) -G042 -V090
+MID_OPTIONS_mus_littleroot_test = -E -R$(STD_REVERB) -G034 -V099
+MID_OPTIONS_mus_credits = -E -R$(STD_REVERB) -G101 -V100
+MID_OPTIONS_mus_title = -E -R$(STD_REVERB) -G059 -V090
+MID_OPTIONS_mus_fallarbor = -E -R$(STD_REVERB) -G083 -V100
+MID_OPTIONS_mus_mt_chimney = -E -R$(STD_REVERB) -G052 -V078
+MID_OPTIONS_mus_follow_me = -E -R$(STD_REVERB) -G066 -V074
+MID_OPTIONS_mus_vs_frontier_brain = -E -R$(STD_REVERB) -G115 -V090 -P1
+MID_OPTIONS_mus_vs_mew = -E -R$(STD_REVERB) -G116 -V090
+MID_OPTIONS_mus_vs_rayquaza = -E -R$(STD_REVERB) -G114 -V080 -P1
+MID_OPTIONS_mus_encounter_hiker = -E -R$(STD_REVERB) -G097 -V076
+MID_OPTIONS_ph_choice_blend = -E -G130 -P4
+MID_OPTIONS_ph_choice_held = -E -G130 -P4
+MID_OPTIONS_ph_choice_solo = -E -G130 -P4
+MID_OPTIONS_ph_cloth_blend = -E -G130 -P4
+MID_OPTIONS_ph_cloth_held = -E -G130 -P4
+MID_OPTIONS_ph_cloth_solo = -E -G130 -P4
+MID_OPTIONS_ph_cure_blend = -E -G130 -P4
+MID_OPTIONS_ph_cure_held = -E -G130 -P4
+MID_OPTIONS_ph_cure_solo = -E -G130 -P4
+MID_OPTIONS_ph_dress_blend = -E -G130 -P4
+MID_OPTIONS_ph_dress_held = -E -G130 -P4
+MID_OPTIONS_ph_dress_solo = -E -G130 -P4
+MID_OPTIONS_ph_face_blend = -E -G130 -P4
+MID_OPTIONS_ph_face_held = -E -G130 -P4
+MID_OPTIONS_ph_face_solo = -E -G130 -P4
+MID_OPTIONS_ph_fleece_blend = -E -G130 -P4
+MID_OPTIONS_ph_fleece_held = -E -G130 -P4
+MID_OPTIONS_ph_fleece_solo = -E -G130 -P4
+MID_OPTIONS_ph_foot_blend = -E -G130 -P4
+MID_OPTIONS_ph_foot_held = -E -G130 -P4
+MID_OPTIONS_ph_foot_solo = -E -G130 -P4
+MID_OPTIONS_ph_goat_blend = -E -G130 -P4
+MID_OPTIONS_ph_goat_held = -E -G130 -P4
+MID_OPTIONS_ph_goat_solo = -E -G130 -P4
+MID_OPTIONS_ph_goose_blend = -E -G130 -P4
+MID_OPTIONS_ph_goose_held = -E -G130 -P4
+MID_OPTIONS_ph_goose_solo = -E -G130 -P4
+MID_OPTIONS_ph_kit_blend = -E -G130 -P4
+MID_OPTIONS_ph_kit_held = -E -G130 -P4
+MID_OPTIONS_ph_kit_solo = -E -G130 -P4
+MID_OPTIONS_ph_lot_blend = -E -G130 -P4
+MID_OPTIONS_ph_lot_held = -E -G130 -P4
+MID_OPTIONS_ph_lot_solo = -E -G130 -P4
+MID_OPTIONS_ph_mouth_blend = -E -G130 -P4
+MID_OPTIONS_ph_mouth_held = -E -G130 -P4
+MID_OPTIONS_ph_mouth_solo = -E -G130 -P4
+MID_OPTIONS_ph_nurse_blend = -E -G130 -P4
+MID_OPTIONS_ph_nurse_held = -E -G130 -P4
+MID_OPTIONS_ph_nurse_solo = -E -G130 -P4
+MID_OPTIONS_ph_price_blend = -E -G130 -P4
+MID_OPTIONS_ph_price_held = -E -G130 -P4
+MID_OPTIONS_ph_price_solo = -E -G130 -P4
+MID_OPTIONS_ph_strut_blend = -E -G130 -P4
+MID_OPTIONS_ph_strut_held = -E -G130 -P4
+MID_OPTIONS_ph_strut_solo = -E -G130 -P4
+MID_OPTIONS_ph_thought_blend = -E -G130 -P4
+MID_OPTIONS_ph_thought_held = -E -G130 -P4
+MID_OPTIONS_ph_thought_solo = -E -G130 -P4
+MID_OPTIONS_ph_trap_blend = -E -G130 -P4
+MID_OPTIONS_ph_trap_held = -E -G130 -P4
+MID_OPTIONS_ph_trap_solo = -E -G130 -P4
+MID_OPTIONS_se_a = -E -R$(STD_REVERB) -G128 -V095 -P4
+MID_OPTIONS_se_bang = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_taillow_wing_flap = -E -R$(STD_REVERB) -G128 -V105 -P5
+MID_OPTIONS_se_glass_flute = -E -R$(STD_REVERB) -G128 -V105 -P5
+MID_OPTIONS_se_boo = -E -R$(STD_REVERB) -G127 -V110 -P4
+MID_OPTIONS_se_ball = -E -R$(STD_REVERB) -G127 -V070 -P4
+MID_OPTIONS_se_ball_open = -E -R$(STD_REVERB) -G127 -V100 -P5
+MID_OPTIONS_se_mugshot = -E -R$(STD_REVERB) -G128 -V090 -P5
+MID_OPTIONS_se_contest_heart = -E -R$(STD_REVERB) -G128 -V090 -P5
+MID_OPTIONS_se_contest_curtain_fall = -E -R$(STD_REVERB) -G128 -V070 -P5
+MID_OPTIONS_se_contest_curtain_rise = -E -R$(STD_REVERB) -G128 -V070 -P5
+MID_OPTIONS_se_contest_icon_change = -E -R$(STD_REVERB) -G128 -V110 -P5
+MID_OPTIONS_se_contest_mons_turn = -E -R$(STD_REVERB) -G128 -V090 -P5
+MID_OPTIONS_se_contest_icon_clear = -E -R$(STD_REVERB) -G128 -V090 -P5
+MID_OPTIONS_se_card = -E -R$(STD_REVERB) -G127 -V100 -P4
+MID_OPTIONS_se_pike_curtain_close = -E -R$(STD_REVERB) -G129 -P5
+MID_OPTIONS_se_pike_curtain_open = -E -R$(STD_REVERB) -G129 -P5
+MID_OPTIONS_se_ledge = -E -R$(STD_REVERB) -G127 -V100 -P4
+MID_OPTIONS_se_itemfinder = -E -R$(STD_REVERB) -G127 -V090 -P5
+MID_OPTIONS_se_applause = -E -R$(STD_REVERB) -G128 -V100 -P5
+MID_OPTIONS_se_field_poison = -E -R$(STD_REVERB) -G127 -V110 -P5
+MID_OPTIONS_se_door = -E -R$(STD_REVERB) -G127 -V080 -P5
+MID_OPTIONS_se_e = -E -R$(STD_REVERB) -G128 -V120 -P4
+MID_OPTIONS_se_elevator = -E -R$(STD_REVERB) -G128 -V100 -P4
+MID_OPTIONS_se_escalator = -E -R$(STD_REVERB) -G128 -V100 -P4
+MID_OPTIONS_se_exp = -E -R$(STD_REVERB) -G127 -V080 -P5
+MID_OPTIONS_se_exp_max = -E -R$(STD_REVERB) -G128 -V094 -P5
+MID_OPTIONS_se_fu_zaku = -E -R$(STD_REVERB) -G127 -V120 -P4
+MID_OPTIONS_se_contest_condition_lose = -E -R$(STD_REVERB) -G127 -V110 -P4
+MID_OPTIONS_se_lavaridge_fall_warp = -E -R$(STD_REVERB) -G127 -P4
+MID_OPTIONS_se_balloon_red = -E -R$(STD_REVERB) -G128 -V105 -P4
+MID_OPTIONS_se_balloon_blue = -E -R$(STD_REVERB) -G128 -V105 -P4
+MID_OPTIONS_se_balloon_yellow = -E -R$(STD_REVERB) -G128 -V105 -P4
+MID_OPTIONS_se_arena_timeup1 = -E -R$(STD_REVERB) -G129 -P5
+MID_OPTIONS_se_arena_timeup2 = -E -R$(STD_REVERB) -G129 -P5
+MID_OPTIONS_se_bridge_walk = -E -R$(STD_REVERB) -G128 -V095 -P4
+MID_OPTIONS_se_failure = -E -R$(STD_REVERB) -G127 -V120 -P4
+MID_OPTIONS_se_rotating_gate = -E -R$(STD_REVERB) -G128 -V090 -P4
+MID_OPTIONS_se_low_health = -E -R$(STD_REVERB) -G127 -V100 -P3
+MID_OPTIONS_se_i = -E -R$(STD_REVERB) -G128 -V120 -P4
+MID_OPTIONS_se_sliding_door = -E -R$(STD_REVERB) -G128 -V095 -P4
+MID_OPTIONS_se_vend = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_bike_hop = -E -R$(STD_REVERB) -G127 -V090 -P4
+MID_OPTIONS_se_bike_bell = -E -R$(STD_REVERB) -G128 -V090 -P4
+MID_OPTIONS_se_contest_place = -E -R$(STD_REVERB) -G127 -V110 -P4
+MID_OPTIONS_se_exit = -E -R$(STD_REVERB) -G127 -V120 -P5
+MID_OPTIONS_se_use_item = -E -R$(STD_REVERB) -G127 -V100 -P5
+MID_OPTIONS_se_unlock = -E -R$(STD_REVERB) -G128 -V100 -P4
+MID_OPTIONS_se_ball_bounce_1 = -E -R$(STD_REVERB) -G128 -V100 -P4
+MID_OPTIONS_se_ball_bounce_2 = -E -R$(STD_REVERB) -G128 -V100 -P4
+MID_OPTIONS_se_ball_bounce_3 = -E -R$(STD_REVERB) -G128 -V100 -P4
+MID_OPTIONS_se_ball_bounce_4 = -E -R$(STD_REVERB) -G128 -V100 -P4
+MID_OPTIONS_se_super_effective = -E -R$(STD_REVERB) -G127 -V110 -P5
+MID_OPTIONS_se_not_effective = -E -R$(STD_REVERB) -G127 -V110 -P5
+MID_OPTIONS_se_effective = -E -R$(STD_REVERB) -G127 -V110 -P5
+MID_OPTIONS_se_puddle = -E -R$(STD_REVERB) -G128 -V020 -P4
+MID_OPTIONS_se_berry_blender = -E -R$(STD_REVERB) -G128 -V090 -P4
+MID_OPTIONS_se_switch = -E -R$(STD_REVERB) -G127 -V100 -P4
+MID_OPTIONS_se_n = -E -R$(STD_REVERB) -G128 -P4
+MID_OPTIONS_se_ball_throw = -E -R$(STD_REVERB) -G128 -V120 -P5
+MID_OPTIONS_se_ship = -E -R$(STD_REVERB) -G127 -V075 -P4
+MID_OPTIONS_se_flee = -E -R$(STD_REVERB) -G127 -V090 -P5
+MID_OPTIONS_se_o = -E -R$(STD_REVERB) -G128 -V120 -P4
+MID_OPTIONS_se_intro_blast = -E -R$(STD_REVERB) -G127 -V100 -P5
+MID_OPTIONS_se_pc_login = -E -R$(STD_REVERB) -G127 -V100 -P5
+MID_OPTIONS_se_pc_off = -E -R$(STD_REVERB) -G127 -V100 -P5
+MID_OPTIONS_se_pc_on = -E -R$(STD_REVERB) -G127 -V100 -P5
+MID_OPTIONS_se_pin = -E -R$(STD_REVERB) -G127 -V060 -P4
+MID_OPTIONS_se_ding_dong = -E -R$(STD_REVERB) -G127 -V090 -P5
+MID_OPTIONS_se_pokenav_off = -E -R$(STD_REVERB) -G127 -V100 -P5
+MID_OPTIONS_se_pokenav_on = -E -R$(STD_REVERB) -G127 -V100 -P5
+MID_OPTIONS_se_faint = -E -R$(STD_REVERB) -G127 -V110 -P5
+MID_OPTIONS_se_shiny = -E -R$(STD_REVERB) -G128 -V095 -P5
+MID_OPTIONS_se_shop = -E -R$(STD_REVERB) -G127 -V090 -P5
+MID_OPTIONS_se_rg_bag_cursor = -E -R$(STD_REVERB) -G129 -P5
+MID_OPTIONS_se_rg_bag_pocket = -E -R$(STD_REVERB) -G129 -P5
+MID_OPTIONS_se_rg_card_flip = -E -R$(STD_REVERB) -G129 -P5
+MID_OPTIONS_se_rg_card_flipping = -E -R$(STD_REVERB) -G129 -P5
+MID_OPTIONS_se_rg_card_open = -E -R$(STD_REVERB) -G129 -V112 -P5
+MID_OPTIONS_se_rg_deoxys_move = -E -R$(STD_REVERB) -G129 -V080 -P5
+MID_OPTIONS_se_rg_poke_jump_success = -E -R$(STD_REVERB) -G128 -V110 -P5
+MID_OPTIONS_se_rg_ball_click = -E -R$(STD_REVERB) -G129 -V100 -P5
+MID_OPTIONS_se_rg_help_close = -E -R$(STD_REVERB) -G129 -V095 -P5
+MID_OPTIONS_se_rg_help_error = -E -R$(STD_REVERB) -G129 -V125 -P5
+MID_OPTIONS_se_rg_help_open = -E -R$(STD_REVERB) -G129 -V096 -P5
+MID_OPTIONS_se_rg_ss_anne_horn = -E -R$(STD_REVERB) -G129 -V096 -P5
+MID_OPTIONS_se_rg_poke_jump_failure = -E -R$(STD_REVERB) -G127 -P5
+MID_OPTIONS_se_rg_shop = -E -R$(STD_REVERB) -G129 -V080 -P5
+MID_OPTIONS_se_rg_door = -E -R$(STD_REVERB) -G129 -V100 -P5
+MID_OPTIONS_se_ice_crack = -E -R$(STD_REVERB) -G127 -V100 -P4
+MID_OPTIONS_se_ice_stairs = -E -R$(STD_REVERB) -G128 -V090 -P4
+MID_OPTIONS_se_ice_break = -E -R$(STD_REVERB) -G128 -V100 -P4
+MID_OPTIONS_se_fall = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_save = -E -R$(STD_REVERB) -G128 -V080 -P5
+MID_OPTIONS_se_success = -E -R$(STD_REVERB) -G127 -V080 -P4
+MID_OPTIONS_se_select = -E -R$(STD_REVERB) -G127 -V080 -P5
+MID_OPTIONS_se_ball_trade = -E -R$(STD_REVERB) -G127 -V100 -P5
+MID_OPTIONS_se_thunderstorm = -E -R$(STD_REVERB) -G128 -V080 -P2
+MID_OPTIONS_se_thunderstorm_stop = -E -R$(STD_REVERB) -G128 -V080 -P2
+MID_OPTIONS_se_thunder = -E -R$(STD_REVERB) -G128 -V110 -P3
+MID_OPTIONS_se_thunder2 = -E -R$(STD_REVERB) -G128 -V110 -P3
+MID_OPTIONS_se_rain = -E -R$(STD_REVERB) -G128 -V080 -P2
+MID_OPTIONS_se_rain_stop = -E -R$(STD_REVERB) -G128 -V080 -P2
+MID_OPTIONS_se_downpour = -E -R$(STD_REVERB) -G128 -V100 -P2
+MID_OPTIONS_se_downpour_stop = -E -R$(STD_REVERB) -G128 -V100 -P2
+MID_OPTIONS_se_orb = -E -R$(STD_REVERB) -G128 -V100 -P5
+MID_OPTIONS_se_egg_hatch = -E -R$(STD_REVERB) -G128 -V120 -P5
+MID_OPTIONS_se_roulette_ball = -E -R$(STD_REVERB) -G128 -V110 -P2
+MID_OPTIONS_se_roulette_ball2 = -E -R$(STD_REVERB) -G128 -V110 -P2
+MID_OPTIONS_se_ball_tray_exit = -E -R$(STD_REVERB) -G127 -V100 -P5
+MID_OPTIONS_se_ball_tray_ball = -E -R$(STD_REVERB) -G128 -V110 -P5
+MID_OPTIONS_se_ball_tray_enter = -E -R$(STD_REVERB) -G128 -V110 -P5
+MID_OPTIONS_se_click = -E -R$(STD_REVERB) -G127 -V110 -P4
+MID_OPTIONS_se_warp_in = -E -R$(STD_REVERB) -G127 -V090 -P4
+MID_OPTIONS_se_warp_out = -E -R$(STD_REVERB) -G127 -V090 -P4
+MID_OPTIONS_se_pokenav_call = -E -R$(STD_REVERB) -G129 -V120 -P5
+MID_OPTIONS_se_pokenav_hang_up = -E -R$(STD_REVERB) -G129 -V110 -P5
+MID_OPTIONS_se_note_a = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_note_b = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_note_c = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_note_c_high = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_note_d = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_mud_ball = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_note_e = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_note_f = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_note_g = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_breakable_door = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_truck_door = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_truck_unload = -E -R$(STD_REVERB) -G127 -P4
+MID_OPTIONS_se_truck_move = -E -R$(STD_REVERB) -G128 -P4
+MID_OPTIONS_se_truck_stop = -E -R$(STD_REVERB) -G128 -P4
+MID_OPTIONS_se_repel = -E -R$(STD_REVERB) -G127 -V090 -P4
+MID_OPTIONS_se_u = -E -R$(STD_REVERB) -G128 -P4
+MID_OPTIONS_se_sudowoodo_shake = -E -R$(STD_REVERB) -G129 -V077 -P5
+MID_OPTIONS_se_m_double_slap = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_comet_punch = -E -R$(STD_REVERB) -G128 -V120 -P4
+MID_OPTIONS_se_m_pay_day = -E -R$(STD_REVERB) -G128 -V095 -P4
+MID_OPTIONS_se_m_fire_punch = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_scratch = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_vicegrip = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_razor_wind = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_razor_wind2 = -E -R$(STD_REVERB) -G128 -V090 -P4
+MID_OPTIONS_se_m_swords_dance = -E -R$(STD_REVERB) -G128 -V100 -P4
+MID_OPTIONS_se_m_cut = -E -R$(STD_REVERB) -G128 -V120 -P4
+MID_OPTIONS_se_m_gust = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_gust2 = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_wing_attack = -E -R$(STD_REVERB) -G128 -V105 -P4
+MID_OPTIONS_se_m_fly = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_bind = -E -R$(STD_REVERB) -G128 -V100 -P4
+MID_OPTIONS_se_m_mega_kick = -E -R$(STD_REVERB) -G128 -V090 -P4
+MID_OPTIONS_se_m_mega_kick2 = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_jump_kick = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_sand_attack = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_headbutt = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_horn_attack = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_take_down = -E -R$(STD_REVERB) -G128 -V105 -P4
+MID_OPTIONS_se_m_tail_whip = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_m_leer = -E -R$(STD_REVERB) -G128 -V110 -P4
+MID_OPTIONS_se_dex_search = -E -R$(STD_REVERB) -G127 -v100 -P5
+
+MID_ASMS := $(MID_SRCS:.mid=.s)
+
+ifneq ($(MID_BATCH),0)
+# The songs hang off a stamp like the map data. Every song that changed since
+# the last run is converted by a single mid2agb -M run, from a manifest of
+# their options. Build with MID_BATCH=0 to run mid2agb once per song instead.
+# The stamp is dropped when any song's .s is missing, so they all get
+# converted.
+MID_MANIFEST := $(MID_BUILDDIR)/songs.manifest
+MID_STAMP := $(MID_BUILDDIR)/songs.stamp
+
+$(if $(filter-out $(wildcard $(MID_ASMS)),$(MID_ASMS)),$(shell rm -f $(MID_STAMP)))
+
+$(MID_STAMP): $(MID_SRCS)
+	@printf '%s\n' $(foreach mid,$?,"$(mid) $(mid:.mid=.s) $(MID_OPTIONS_$(basename $(notdir $(mid))))") >$(MID_MANIFEST)
+	@echo "$(MID) -M $(MID_MANIFEST) <$(words $?) songs>"
+	@$(MID) -M $(MID_MANIFEST)
+	@touch $@
+$(MID_ASMS): $(MID_STAMP) ;
+else
+$(MID_SUBDIR)/%.s: $(MID_SUBDIR)/%.mid
+	$(MID) $< $@ $(MID_OPTIONS_$*)
+endif
+
 $(MID_BUILDDIR)/%.o: $(MID_SUBDIR)/%.s
 	$(AS) $(ASFLAGS) -I sound -o $@ $<
-
-$(MID_SUBDIR)/mus_aqua_magma_hideout.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G076 -V084
-
-$(MID_SUBDIR)/mus_encounter_aqua.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G065 -V086
-
-$(MID_SUBDIR)/mus_route111.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G055 -V076
-
-$(MID_SUBDIR)/mus_encounter_suspicious.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G069 -V078
-
-$(MID_SUBDIR)/mus_b_arena.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G104 -V090
-
-$(MID_SUBDIR)/mus_b_dome.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G111 -V090
-
-$(MID_SUBDIR)/mus_b_dome_lobby.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G111 -V056
-
-$(MID_SUBDIR)/mus_b_factory.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G113 -V100
-
-$(MID_SUBDIR)/mus_b_frontier.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G103 -V094
-
-$(MID_SUBDIR)/mus_b_palace.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G108 -V105
-
-$(MID_SUBDIR)/mus_b_tower_rs.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G035 -V080
-
-$(MID_SUBDIR)/mus_b_pike.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G112 -V092
-
-$(MID_SUBDIR)/mus_vs_trainer.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G119 -V080 -P1
-
-$(MID_SUBDIR)/mus_vs_wild.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G117 -V080 -P1
-
-$(MID_SUBDIR)/mus_vs_aqua_magma_leader.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G126 -V080 -P1
-
-$(MID_SUBDIR)/mus_vs_aqua_magma.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G118 -V080 -P1
-
-$(MID_SUBDIR)/mus_vs_gym_leader.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G120 -V080 -P1
-
-$(MID_SUBDIR)/mus_vs_champion.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G121 -V080 -P1
-
-$(MID_SUBDIR)/mus_vs_kyogre_groudon.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G123 -V080 -P1
-
-$(MID_SUBDIR)/mus_vs_rival.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G124 -V080 -P1
-
-$(MID_SUBDIR)/mus_vs_regi.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G122 -V080 -P1
-
-$(MID_SUBDIR)/mus_vs_elite_four.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G125 -V080 -P1
-
-$(MID_SUBDIR)/mus_roulette.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G038 -V080
-
-$(MID_SUBDIR)/mus_lilycove_museum.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G020 -V080
-
-$(MID_SUBDIR)/mus_encounter_brendan.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G067 -V078
-
-$(MID_SUBDIR)/mus_encounter_male.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G028 -V080
-
-$(MID_SUBDIR)/mus_victory_road.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G075 -V076
-
-$(MID_SUBDIR)/mus_game_corner.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G072 -V072
-
-$(MID_SUBDIR)/mus_contest_winner.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G085 -V100
-
-$(MID_SUBDIR)/mus_contest_results.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G092 -V080
-
-$(MID_SUBDIR)/mus_contest_lobby.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G098 -V060
-
-$(MID_SUBDIR)/mus_contest.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G086 -V088
-
-$(MID_SUBDIR)/mus_cycling.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G049 -V083
-
-$(MID_SUBDIR)/mus_encounter_champion.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G100 -V076
-
-$(MID_SUBDIR)/mus_petalburg_woods.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G018 -V080
-
-$(MID_SUBDIR)/mus_abandoned_ship.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G030 -V080
-
-$(MID_SUBDIR)/mus_cave_of_origin.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G037 -V080
-
-$(MID_SUBDIR)/mus_underwater.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G057 -V094
-
-$(MID_SUBDIR)/mus_intro.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G060 -V090
-
-$(MID_SUBDIR)/mus_hall_of_fame.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G082 -V078
-
-$(MID_SUBDIR)/mus_route110.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G010 -V080
-
-$(MID_SUBDIR)/mus_route120.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G014 -V080
-
-$(MID_SUBDIR)/mus_route122.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G021 -V080
-
-$(MID_SUBDIR)/mus_route101.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G011 -V080
-
-$(MID_SUBDIR)/mus_dummy.s: %.s: %.mid
-	$(MID) $< $@ -E -R40
-
-$(MID_SUBDIR)/mus_hall_of_fame_room.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G093 -V080
-
-$(MID_SUBDIR)/mus_end.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G102 -V036
-
-$(MID_SUBDIR)/mus_help.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G056 -V078
-
-$(MID_SUBDIR)/mus_level_up.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G012 -V090 -P5
-
-$(MID_SUBDIR)/mus_obtain_item.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G012 -V090 -P5
-
-$(MID_SUBDIR)/mus_evolved.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G012 -V090 -P5
-
-$(MID_SUBDIR)/mus_gsc_route38.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -V080
-
-$(MID_SUBDIR)/mus_slateport.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G079 -V070
-
-$(MID_SUBDIR)/mus_poke_mart.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G050 -V085
-
-$(MID_SUBDIR)/mus_oceanic_museum.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G023 -V080
-
-$(MID_SUBDIR)/mus_gym.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G013 -V080
-
-$(MID_SUBDIR)/mus_encounter_may.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G061 -V078
-
-$(MID_SUBDIR)/mus_encounter_female.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G053 -V072
-
-$(MID_SUBDIR)/mus_verdanturf.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G044 -V090
-
-$(MID_SUBDIR)/mus_rustboro.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G045 -V085
-
-$(MID_SUBDIR)/mus_route119.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G048 -V096
-
-$(MID_SUBDIR)/mus_encounter_intense.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G062 -V078
-
-$(MID_SUBDIR)/mus_weather_groudon.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G090 -V050
-
-$(MID_SUBDIR)/mus_dewford.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G073 -V078
-
-$(MID_SUBDIR)/mus_encounter_twins.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G095 -V075
-
-$(MID_SUBDIR)/mus_encounter_interviewer.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G099 -V062
-
-$(MID_SUBDIR)/mus_victory_trainer.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G058 -V091
-
-$(MID_SUBDIR)/mus_victory_wild.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G025 -V080
-
-$(MID_SUBDIR)/mus_victory_gym_leader.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G024 -V080
-
-$(MID_SUBDIR)/mus_victory_aqua_magma.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G070 -V088
-
-$(MID_SUBDIR)/mus_victory_league.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G029 -V080
-
-$(MID_SUBDIR)/mus_caught.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G025 -V080
-
-$(MID_SUBDIR)/mus_encounter_cool.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G063 -V086
-
-$(MID_SUBDIR)/mus_trick_house.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G094 -V070
-
-$(MID_SUBDIR)/mus_route113.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G064 -V084
-
-$(MID_SUBDIR)/mus_sailing.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G077 -V086
-
-$(MID_SUBDIR)/mus_mt_pyre.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G078 -V088
-
-$(MID_SUBDIR)/mus_sealed_chamber.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G084 -V100
-
-$(MID_SUBDIR)/mus_petalburg.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G015 -V080
-
-$(MID_SUBDIR)/mus_fortree.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G032 -V080
-
-$(MID_SUBDIR)/mus_oldale.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G019 -V080
-
-$(MID_SUBDIR)/mus_mt_pyre_exterior.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G080 -V080
-
-$(MID_SUBDIR)/mus_heal.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G012 -V090 -P5
-
-$(MID_SUBDIR)/mus_slots_jackpot.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G012 -V090 -P5
-
-$(MID_SUBDIR)/mus_slots_win.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G012 -V090 -P5
-
-$(MID_SUBDIR)/mus_obtain_badge.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G012 -V090 -P5
-
-$(MID_SUBDIR)/mus_obtain_berry.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G012 -V090 -P5
-
-$(MID_SUBDIR)/mus_obtain_b_points.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G103 -V090 -P5
-
-$(MID_SUBDIR)/mus_rg_photo.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G180 -V100 -P5
-
-$(MID_SUBDIR)/mus_evolution_intro.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G026 -V080
-
-$(MID_SUBDIR)/mus_obtain_symbol.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G103 -V100 -P5
-
-$(MID_SUBDIR)/mus_awaken_legend.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G012 -V090 -P5
-
-$(MID_SUBDIR)/mus_register_match_call.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G105 -V090 -P5
-
-$(MID_SUBDIR)/mus_move_deleted.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G012 -V090 -P5
-
-$(MID_SUBDIR)/mus_obtain_tmhm.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G012 -V090 -P5
-
-$(MID_SUBDIR)/mus_too_bad.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G012 -V090 -P5
-
-$(MID_SUBDIR)/mus_encounter_magma.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G087 -V072
-
-$(MID_SUBDIR)/mus_lilycove.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G054 -V085
-
-$(MID_SUBDIR)/mus_littleroot.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G051 -V100
-
-$(MID_SUBDIR)/mus_surf.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G017 -V080
-
-$(MID_SUBDIR)/mus_route104.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G047 -V097
-
-$(MID_SUBDIR)/mus_gsc_pewter.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -V080
-
-$(MID_SUBDIR)/mus_birch_lab.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G033 -V080
-
-$(MID_SUBDIR)/mus_abnormal_weather.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G089 -V080
-
-$(MID_SUBDIR)/mus_school.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G081 -V100
-
-$(MID_SUBDIR)/mus_c_comm_center.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -V080
-
-$(MID_SUBDIR)/mus_poke_center.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G046 -V092
-
-$(MID_SUBDIR)/mus_b_pyramid.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G106 -V079
-
-$(MID_SUBDIR)/mus_b_pyramid_top.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G107 -V077
-
-$(MID_SUBDIR)/mus_ever_grande.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G068 -V086
-
-$(MID_SUBDIR)/mus_rayquaza_appears.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G109 -V090
-
-$(MID_SUBDIR)/mus_rg_rocket_hideout.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G133 -V090
-
-$(MID_SUBDIR)/mus_rg_follow_me.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G131 -V068
-
-$(MID_SUBDIR)/mus_rg_victory_road.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G154 -V090
-
-$(MID_SUBDIR)/mus_rg_cycling.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G141 -V090
-
-$(MID_SUBDIR)/mus_rg_intro_fight.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G136 -V090
-
-$(MID_SUBDIR)/mus_rg_hall_of_fame.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G145 -V079
-
-$(MID_SUBDIR)/mus_rg_encounter_deoxys.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G184 -V079
-
-$(MID_SUBDIR)/mus_rg_credits.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G149 -V090
-
-$(MID_SUBDIR)/mus_rg_encounter_gym_leader.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G144 -V090
-
-$(MID_SUBDIR)/mus_rg_dex_rating.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G175 -V070 -P5
-
-$(MID_SUBDIR)/mus_rg_obtain_key_item.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G178 -V077 -P5
-
-$(MID_SUBDIR)/mus_rg_caught_intro.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G179 -V094 -P5
-
-$(MID_SUBDIR)/mus_rg_caught.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G170 -V100
-
-$(MID_SUBDIR)/mus_rg_cinnabar.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G138 -V090
-
-$(MID_SUBDIR)/mus_rg_gym.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G134 -V090
-
-$(MID_SUBDIR)/mus_rg_fuchsia.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G167 -V090
-
-$(MID_SUBDIR)/mus_rg_poke_jump.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G132 -V090
-
-$(MID_SUBDIR)/mus_rg_heal.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G140 -V090
-
-$(MID_SUBDIR)/mus_rg_oak_lab.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G160 -V075
-
-$(MID_SUBDIR)/mus_rg_berry_pick.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G132 -V090
-
-$(MID_SUBDIR)/mus_rg_vermillion.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G172 -V090
-
-$(MID_SUBDIR)/mus_rg_route1.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G150 -V079
-
-$(MID_SUBDIR)/mus_rg_route3.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G152 -V083
-
-$(MID_SUBDIR)/mus_rg_route11.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G153 -V090
-
-$(MID_SUBDIR)/mus_rg_pallet.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G159 -V100
-
-$(MID_SUBDIR)/mus_rg_surf.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G164 -V071
-
-$(MID_SUBDIR)/mus_rg_sevii_45.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G188 -V084
-
-$(MID_SUBDIR)/mus_rg_sevii_67.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G189 -V084
-
-$(MID_SUBDIR)/mus_rg_sevii_123.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G173 -V084
-
-$(MID_SUBDIR)/mus_rg_sevii_cave.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G147 -V090
-
-$(MID_SUBDIR)/mus_rg_sevii_dungeon.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G146 -V090
-
-$(MID_SUBDIR)/mus_rg_sevii_route.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G187 -V080
-
-$(MID_SUBDIR)/mus_rg_net_center.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G162 -V096
-
-$(MID_SUBDIR)/mus_rg_pewter.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G173 -V084
-
-$(MID_SUBDIR)/mus_rg_oak.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G161 -V086
-
-$(MID_SUBDIR)/mus_rg_mystery_gift.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G183 -V100
-
-$(MID_SUBDIR)/mus_rg_route24.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G151 -V086
-
-$(MID_SUBDIR)/mus_rg_teachy_tv_show.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G131 -V068
-
-$(MID_SUBDIR)/mus_rg_mt_moon.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G147 -V090
-
-$(MID_SUBDIR)/mus_rg_poke_tower.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G165 -V090
-
-$(MID_SUBDIR)/mus_rg_poke_center.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G162 -V096
-
-$(MID_SUBDIR)/mus_rg_poke_flute.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G165 -V048 -P5
-
-$(MID_SUBDIR)/mus_rg_poke_mansion.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G148 -V090
-
-$(MID_SUBDIR)/mus_rg_jigglypuff.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G135 -V068 -P5
-
-$(MID_SUBDIR)/mus_rg_encounter_rival.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G174 -V079
-
-$(MID_SUBDIR)/mus_rg_rival_exit.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G174 -V079
-
-$(MID_SUBDIR)/mus_rg_encounter_rocket.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G142 -V096
-
-$(MID_SUBDIR)/mus_rg_ss_anne.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G163 -V090
-
-$(MID_SUBDIR)/mus_rg_new_game_exit.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G182 -V088
-
-$(MID_SUBDIR)/mus_rg_new_game_intro.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G182 -V088
-
-$(MID_SUBDIR)/mus_rg_lavender.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G139 -V090
-
-$(MID_SUBDIR)/mus_rg_silph.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G166 -V076
-
-$(MID_SUBDIR)/mus_rg_encounter_girl.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G143 -V051
-
-$(MID_SUBDIR)/mus_rg_encounter_boy.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G144 -V090
-
-$(MID_SUBDIR)/mus_rg_game_corner.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G132 -V090
-
-$(MID_SUBDIR)/mus_rg_slow_pallet.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G159 -V092
-
-$(MID_SUBDIR)/mus_rg_new_game_instruct.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G182 -V085
-
-$(MID_SUBDIR)/mus_rg_viridian_forest.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G146 -V090
-
-$(MID_SUBDIR)/mus_rg_trainer_tower.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G134 -V090
-
-$(MID_SUBDIR)/mus_rg_celadon.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G168 -V070
-
-$(MID_SUBDIR)/mus_rg_title.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G137 -V090
-
-$(MID_SUBDIR)/mus_rg_game_freak.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G181 -V075
-
-$(MID_SUBDIR)/mus_rg_teachy_tv_menu.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G186 -V059
-
-$(MID_SUBDIR)/mus_rg_union_room.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G132 -V090
-
-$(MID_SUBDIR)/mus_rg_vs_legend.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G157 -V090
-
-$(MID_SUBDIR)/mus_rg_vs_deoxys.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G185 -V080
-
-$(MID_SUBDIR)/mus_rg_vs_gym_leader.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G155 -V090
-
-$(MID_SUBDIR)/mus_rg_vs_champion.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G158 -V090
-
-$(MID_SUBDIR)/mus_rg_vs_mewtwo.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G157 -V090
-
-$(MID_SUBDIR)/mus_rg_vs_trainer.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G156 -V090
-
-$(MID_SUBDIR)/mus_rg_vs_wild.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G157 -V090
-
-$(MID_SUBDIR)/mus_rg_victory_gym_leader.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G171 -V090
-
-$(MID_SUBDIR)/mus_rg_victory_trainer.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G169 -V089
-
-$(MID_SUBDIR)/mus_rg_victory_wild.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G170 -V090
-
-$(MID_SUBDIR)/mus_cable_car.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G071 -V078
-
-$(MID_SUBDIR)/mus_sootopolis.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G091 -V062
-
-$(MID_SUBDIR)/mus_safari_zone.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G074 -V082
-
-$(MID_SUBDIR)/mus_b_tower.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G110 -V100
-
-$(MID_SUBDIR)/mus_evolution.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G026 -V080
-
-$(MID_SUBDIR)/mus_encounter_elite_four.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G096 -V078
-
-$(MID_SUBDIR)/mus_c_vs_legend_beast.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -V080
-
-$(MID_SUBDIR)/mus_encounter_swimmer.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G036 -V080
-
-$(MID_SUBDIR)/mus_encounter_girl.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G027 -V080
-
-$(MID_SUBDIR)/mus_intro_battle.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G088 -V088
-
-$(MID_SUBDIR)/mus_encounter_rich.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G043 -V094
-
-$(MID_SUBDIR)/mus_link_contest_p1.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G039 -V079
-
-$(MID_SUBDIR)/mus_link_contest_p2.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G040 -V090
-
-$(MID_SUBDIR)/mus_link_contest_p3.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G041 -V075
-
-$(MID_SUBDIR)/mus_link_contest_p4.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G042 -V090
-
-$(MID_SUBDIR)/mus_littleroot_test.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G034 -V099
-
-$(MID_SUBDIR)/mus_credits.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G101 -V100
-
-$(MID_SUBDIR)/mus_title.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G059 -V090
-
-$(MID_SUBDIR)/mus_fallarbor.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G083 -V100
-
-$(MID_SUBDIR)/mus_mt_chimney.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G052 -V078
-
-$(MID_SUBDIR)/mus_follow_me.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G066 -V074
-
-$(MID_SUBDIR)/mus_vs_frontier_brain.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G115 -V090 -P1
-
-$(MID_SUBDIR)/mus_vs_mew.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G116 -V090
-
-$(MID_SUBDIR)/mus_vs_rayquaza.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G114 -V080 -P1
-
-$(MID_SUBDIR)/mus_encounter_hiker.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G097 -V076
-
-$(MID_SUBDIR)/ph_choice_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_choice_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_choice_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_cloth_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_cloth_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_cloth_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_cure_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_cure_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_cure_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_dress_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_dress_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_dress_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_face_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_face_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_face_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_fleece_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_fleece_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_fleece_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_foot_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_foot_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_foot_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_goat_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_goat_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_goat_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_goose_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_goose_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_goose_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_kit_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_kit_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_kit_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_lot_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_lot_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_lot_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_mouth_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_mouth_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_mouth_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_nurse_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_nurse_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_nurse_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_price_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_price_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_price_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_strut_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_strut_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_strut_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_thought_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_thought_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_thought_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_trap_blend.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_trap_held.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/ph_trap_solo.s: %.s: %.mid
-	$(MID) $< $@ -E -G130 -P4
-
-$(MID_SUBDIR)/se_a.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V095 -P4
-
-$(MID_SUBDIR)/se_bang.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_taillow_wing_flap.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V105 -P5
-
-$(MID_SUBDIR)/se_glass_flute.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V105 -P5
-
-$(MID_SUBDIR)/se_boo.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V110 -P4
-
-$(MID_SUBDIR)/se_ball.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V070 -P4
-
-$(MID_SUBDIR)/se_ball_open.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P5
-
-$(MID_SUBDIR)/se_mugshot.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V090 -P5
-
-$(MID_SUBDIR)/se_contest_heart.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V090 -P5
-
-$(MID_SUBDIR)/se_contest_curtain_fall.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V070 -P5
-
-$(MID_SUBDIR)/se_contest_curtain_rise.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V070 -P5
-
-$(MID_SUBDIR)/se_contest_icon_change.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P5
-
-$(MID_SUBDIR)/se_contest_mons_turn.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V090 -P5
-
-$(MID_SUBDIR)/se_contest_icon_clear.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V090 -P5
-
-$(MID_SUBDIR)/se_card.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P4
-
-$(MID_SUBDIR)/se_pike_curtain_close.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -P5
-
-$(MID_SUBDIR)/se_pike_curtain_open.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -P5
-
-$(MID_SUBDIR)/se_ledge.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P4
-
-$(MID_SUBDIR)/se_itemfinder.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V090 -P5
-
-$(MID_SUBDIR)/se_applause.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P5
-
-$(MID_SUBDIR)/se_field_poison.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V110 -P5
-
-$(MID_SUBDIR)/se_door.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V080 -P5
-
-$(MID_SUBDIR)/se_e.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V120 -P4
-
-$(MID_SUBDIR)/se_elevator.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P4
-
-$(MID_SUBDIR)/se_escalator.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P4
-
-$(MID_SUBDIR)/se_exp.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V080 -P5
-
-$(MID_SUBDIR)/se_exp_max.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V094 -P5
-
-$(MID_SUBDIR)/se_fu_zaku.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V120 -P4
-
-$(MID_SUBDIR)/se_contest_condition_lose.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V110 -P4
-
-$(MID_SUBDIR)/se_lavaridge_fall_warp.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -P4
-
-$(MID_SUBDIR)/se_balloon_red.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V105 -P4
-
-$(MID_SUBDIR)/se_balloon_blue.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V105 -P4
-
-$(MID_SUBDIR)/se_balloon_yellow.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V105 -P4
-
-$(MID_SUBDIR)/se_arena_timeup1.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -P5
-
-$(MID_SUBDIR)/se_arena_timeup2.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -P5
-
-$(MID_SUBDIR)/se_bridge_walk.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V095 -P4
-
-$(MID_SUBDIR)/se_failure.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V120 -P4
-
-$(MID_SUBDIR)/se_rotating_gate.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V090 -P4
-
-$(MID_SUBDIR)/se_low_health.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P3
-
-$(MID_SUBDIR)/se_i.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V120 -P4
-
-$(MID_SUBDIR)/se_sliding_door.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V095 -P4
-
-$(MID_SUBDIR)/se_vend.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_bike_hop.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V090 -P4
-
-$(MID_SUBDIR)/se_bike_bell.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V090 -P4
-
-$(MID_SUBDIR)/se_contest_place.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V110 -P4
-
-$(MID_SUBDIR)/se_exit.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V120 -P5
-
-$(MID_SUBDIR)/se_use_item.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P5
-
-$(MID_SUBDIR)/se_unlock.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P4
-
-$(MID_SUBDIR)/se_ball_bounce_1.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P4
-
-$(MID_SUBDIR)/se_ball_bounce_2.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P4
-
-$(MID_SUBDIR)/se_ball_bounce_3.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P4
-
-$(MID_SUBDIR)/se_ball_bounce_4.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P4
-
-$(MID_SUBDIR)/se_super_effective.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V110 -P5
-
-$(MID_SUBDIR)/se_not_effective.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V110 -P5
-
-$(MID_SUBDIR)/se_effective.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V110 -P5
-
-$(MID_SUBDIR)/se_puddle.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V020 -P4
-
-$(MID_SUBDIR)/se_berry_blender.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V090 -P4
-
-$(MID_SUBDIR)/se_switch.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P4
-
-$(MID_SUBDIR)/se_n.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -P4
-
-$(MID_SUBDIR)/se_ball_throw.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V120 -P5
-
-$(MID_SUBDIR)/se_ship.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V075 -P4
-
-$(MID_SUBDIR)/se_flee.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V090 -P5
-
-$(MID_SUBDIR)/se_o.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V120 -P4
-
-$(MID_SUBDIR)/se_intro_blast.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P5
-
-$(MID_SUBDIR)/se_pc_login.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P5
-
-$(MID_SUBDIR)/se_pc_off.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P5
-
-$(MID_SUBDIR)/se_pc_on.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P5
-
-$(MID_SUBDIR)/se_pin.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V060 -P4
-
-$(MID_SUBDIR)/se_ding_dong.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V090 -P5
-
-$(MID_SUBDIR)/se_pokenav_off.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P5
-
-$(MID_SUBDIR)/se_pokenav_on.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P5
-
-$(MID_SUBDIR)/se_faint.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V110 -P5
-
-$(MID_SUBDIR)/se_shiny.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V095 -P5
-
-$(MID_SUBDIR)/se_shop.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V090 -P5
-
-$(MID_SUBDIR)/se_rg_bag_cursor.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -P5
-
-$(MID_SUBDIR)/se_rg_bag_pocket.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -P5
-
-$(MID_SUBDIR)/se_rg_card_flip.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -P5
-
-$(MID_SUBDIR)/se_rg_card_flipping.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -P5
-
-$(MID_SUBDIR)/se_rg_card_open.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -V112 -P5
-
-$(MID_SUBDIR)/se_rg_deoxys_move.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -V080 -P5
-
-$(MID_SUBDIR)/se_rg_poke_jump_success.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P5
-
-$(MID_SUBDIR)/se_rg_ball_click.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -V100 -P5
-
-$(MID_SUBDIR)/se_rg_help_close.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -V095 -P5
-
-$(MID_SUBDIR)/se_rg_help_error.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -V125 -P5
-
-$(MID_SUBDIR)/se_rg_help_open.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -V096 -P5
-
-$(MID_SUBDIR)/se_rg_ss_anne_horn.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -V096 -P5
-
-$(MID_SUBDIR)/se_rg_poke_jump_failure.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -P5
-
-$(MID_SUBDIR)/se_rg_shop.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -V080 -P5
-
-$(MID_SUBDIR)/se_rg_door.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -V100 -P5
-
-$(MID_SUBDIR)/se_ice_crack.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P4
-
-$(MID_SUBDIR)/se_ice_stairs.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V090 -P4
-
-$(MID_SUBDIR)/se_ice_break.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P4
-
-$(MID_SUBDIR)/se_fall.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_save.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V080 -P5
-
-$(MID_SUBDIR)/se_success.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V080 -P4
-
-$(MID_SUBDIR)/se_select.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V080 -P5
-
-$(MID_SUBDIR)/se_ball_trade.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P5
-
-$(MID_SUBDIR)/se_thunderstorm.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V080 -P2
-
-$(MID_SUBDIR)/se_thunderstorm_stop.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V080 -P2
-
-$(MID_SUBDIR)/se_thunder.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P3
-
-$(MID_SUBDIR)/se_thunder2.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P3
-
-$(MID_SUBDIR)/se_rain.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V080 -P2
-
-$(MID_SUBDIR)/se_rain_stop.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V080 -P2
-
-$(MID_SUBDIR)/se_downpour.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P2
-
-$(MID_SUBDIR)/se_downpour_stop.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P2
-
-$(MID_SUBDIR)/se_orb.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P5
-
-$(MID_SUBDIR)/se_egg_hatch.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V120 -P5
-
-$(MID_SUBDIR)/se_roulette_ball.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P2
-
-$(MID_SUBDIR)/se_roulette_ball2.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P2
-
-$(MID_SUBDIR)/se_ball_tray_exit.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V100 -P5
-
-$(MID_SUBDIR)/se_ball_tray_ball.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P5
-
-$(MID_SUBDIR)/se_ball_tray_enter.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P5
-
-$(MID_SUBDIR)/se_click.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V110 -P4
-
-$(MID_SUBDIR)/se_warp_in.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V090 -P4
-
-$(MID_SUBDIR)/se_warp_out.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V090 -P4
-
-$(MID_SUBDIR)/se_pokenav_call.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -V120 -P5
-
-$(MID_SUBDIR)/se_pokenav_hang_up.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -V110 -P5
-
-$(MID_SUBDIR)/se_note_a.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_note_b.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_note_c.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_note_c_high.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_note_d.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_mud_ball.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_note_e.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_note_f.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_note_g.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_breakable_door.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_truck_door.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_truck_unload.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -P4
-
-$(MID_SUBDIR)/se_truck_move.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -P4
-
-$(MID_SUBDIR)/se_truck_stop.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -P4
-
-$(MID_SUBDIR)/se_repel.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -V090 -P4
-
-$(MID_SUBDIR)/se_u.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -P4
-
-$(MID_SUBDIR)/se_sudowoodo_shake.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G129 -V077 -P5
-
-$(MID_SUBDIR)/se_m_double_slap.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_comet_punch.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V120 -P4
-
-$(MID_SUBDIR)/se_m_pay_day.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V095 -P4
-
-$(MID_SUBDIR)/se_m_fire_punch.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_scratch.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_vicegrip.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_razor_wind.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_razor_wind2.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V090 -P4
-
-$(MID_SUBDIR)/se_m_swords_dance.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P4
-
-$(MID_SUBDIR)/se_m_cut.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V120 -P4
-
-$(MID_SUBDIR)/se_m_gust.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_gust2.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_wing_attack.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V105 -P4
-
-$(MID_SUBDIR)/se_m_fly.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_bind.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V100 -P4
-
-$(MID_SUBDIR)/se_m_mega_kick.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V090 -P4
-
-$(MID_SUBDIR)/se_m_mega_kick2.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_jump_kick.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_sand_attack.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_headbutt.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_horn_attack.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_take_down.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V105 -P4
-
-$(MID_SUBDIR)/se_m_tail_whip.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_m_leer.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G128 -V110 -P4
-
-$(MID_SUBDIR)/se_dex_search.s: %.s: %.mid
-	$(MID) $< $@ -E -R$(STD_REVERB) -G127 -v100 -P5
@@ -18,12 +18,32 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <limits.h>
+#include <math.h>
+#include <ctype.h>
+#include <time.h>
+#include <stdarg.h>
+#include <setjmp.h>
+
+#ifndef _MSC_VER
+#include <pthread.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 /* extended.c */
 void ieee754_write_extended (double, uint8_t*);
@@ -31,24 +51,22 @@ double ieee754_read_extended (uint8_t*);
 
 #ifdef _MSC_VER
 
-#define FATAL_ERROR(format, ...)           \
-do                                         \
-{                                          \
-	fprintf(stderr, format, __VA_ARGS__);  \
-	exit(1);                               \
-} while (0)
+#define THREAD_LOCAL __declspec(thread)
+#define NORETURN __declspec(noreturn)
+
+#define FATAL_ERROR(format, ...) fatal_error(format, __VA_ARGS__)
 
 #else
 
-#define FATAL_ERROR(format, ...)            \
-do                                          \
-{                                           \
-	fprintf(stderr, format, ##__VA_ARGS__); \
-	exit(1);                                \
-} while (0)
+#define THREAD_LOCAL _Thread_local
+#define NORETURN __attribute__((noreturn))
+
+#define FATAL_ERROR(format, ...) fatal_error(format, ##__VA_ARGS__)
 
 #endif // _MSC_VER
 
+NORETURN void fatal_error(const char *format, ...);
+
 typedef struct {
 	unsigned long num_samples;
 	union {
@@ -74,6 +92,75 @@ struct Marker {
 	// don't care about the name
 };
 
+// Options for converting an .aif, from the command line or a manifest line.
+struct ConvertOptions {
+	bool compress;
+	bool trellis;
+	double rate;
+	bool normalize;
+	bool dither;
+};
+
+// One "input_file output_file [options]" line of a batch manifest.
+struct ManifestEntry {
+	int line_num;
+	char *input_file;
+	char *output_file;
+	struct ConvertOptions options;
+	// Why converting the entry failed, or NULL.
+	char *error;
+};
+
+// What the thread is doing, so that errors can name the manifest entry and
+// clean up after themselves. While a manifest worker converts an entry,
+// on_error is set, and an error is recorded in the entry instead of ending
+// the process.
+struct ThreadContext {
+	struct ManifestEntry *entry;
+	jmp_buf *on_error;
+	char *temp_filename;
+};
+
+const char *gManifestFilename;
+THREAD_LOCAL struct ThreadContext gThreadContext;
+
+// Removes the output being written, if any. Then either records the error
+// for the manifest worker, which jumps back to its next entry, or reports it
+// and exits.
+void fatal_error(const char *format, ...)
+{
+	struct ThreadContext *context = &gThreadContext;
+	va_list args;
+
+	if (context->temp_filename)
+	{
+		remove(context->temp_filename);
+		free(context->temp_filename);
+		context->temp_filename = NULL;
+	}
+
+	if (context->on_error)
+	{
+		va_start(args, format);
+		int length = vsnprintf(NULL, 0, format, args);
+		va_end(args);
+		context->entry->error = malloc(length + 1);
+		va_start(args, format);
+		vsnprintf(context->entry->error, length + 1, format, args);
+		va_end(args);
+		longjmp(*context->on_error, 1);
+	}
+
+	if (context->entry)
+	{
+		fprintf(stderr, "%s:%d: %s: ", gManifestFilename, context->entry->line_num, context->entry->input_file);
+	}
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	exit(1);
+}
+
 struct Bytes *read_bytearray(const char *filename)
 {
 	struct Bytes *bytes = malloc(sizeof(struct Bytes));
@@ -95,15 +182,81 @@ struct Bytes *read_bytearray(const char *filename)
 	return bytes;
 }
 
+#ifdef _WIN32
+
+struct Bytes *map_bytearray(const char *filename)
+{
+	return read_bytearray(filename);
+}
+
+void unmap_bytearray(struct Bytes *bytes)
+{
+	free(bytes->data);
+	free(bytes);
+}
+
+#else
+
+// Like read_bytearray, but maps the file instead of copying it.
+struct Bytes *map_bytearray(const char *filename)
+{
+	struct Bytes *bytes = malloc(sizeof(struct Bytes));
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0)
+	{
+		FATAL_ERROR("Failed to open '%s' for reading!\n", filename);
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		FATAL_ERROR("Failed to read data from '%s'!\n", filename);
+	}
+	bytes->length = st.st_size;
+	bytes->data = mmap(NULL, bytes->length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (bytes->data == MAP_FAILED)
+	{
+		FATAL_ERROR("Failed to read data from '%s'!\n", filename);
+	}
+	return bytes;
+}
+
+void unmap_bytearray(struct Bytes *bytes)
+{
+	munmap(bytes->data, bytes->length);
+	free(bytes);
+}
+
+#endif // _WIN32
+
+// Writes to a temporary file first, so an interrupted run never leaves a
+// truncated output that looks up to date.
 void write_bytearray(const char *filename, struct Bytes *bytes)
 {
-	FILE *f = fopen(filename, "wb");
+	char *temp_filename = malloc(strlen(filename) + 5);
+	strcpy(temp_filename, filename);
+	strcat(temp_filename, ".tmp");
+	FILE *f = fopen(temp_filename, "wb");
 	if (!f)
 	{
+		free(temp_filename);
 		FATAL_ERROR("Failed to open '%s' for writing!\n", filename);
 	}
+	gThreadContext.temp_filename = temp_filename;
 	fwrite(bytes->data, bytes->length, 1, f);
-	fclose(f);
+	if (fclose(f) != 0)
+	{
+		FATAL_ERROR("Failed to write '%s'!\n", filename);
+	}
+#ifdef _WIN32
+	remove(filename);
+#endif
+	if (rename(temp_filename, filename) != 0)
+	{
+		FATAL_ERROR("Failed to write '%s'!\n", filename);
+	}
+	gThreadContext.temp_filename = NULL;
+	free(temp_filename);
 }
 
 void free_bytearray(struct Bytes *bytes)
@@ -482,7 +635,169 @@ int get_delta_index(uint8_t sample, uint8_t prev_sample)
 	return best_index;
 }
 
-struct Bytes *delta_compress(struct Bytes *pcm)
+// Best delta index for every (previous sample, sample) pair, so the
+// compressor doesn't have to search the delta table for each sample.
+static uint8_t gDeltaIndexTable[256][256];
+
+void init_delta_index_table(void)
+{
+	// Gives the same answers as get_delta_index(). Within each direction
+	// the deltas are in ascending order, and a delta that wraps past the
+	// end of the signed range is never the closest, so the best index
+	// only ever moves one way as the sample moves away from prev_sample.
+	for (int prev_sample = 0; prev_sample < 256; prev_sample++)
+	{
+		int prev_sample_signed = U8_TO_S8(prev_sample);
+		uint8_t *row = gDeltaIndexTable[prev_sample];
+
+		int i = POSITIVE_DELTAS_START;
+		for (int sample_signed = prev_sample_signed; sample_signed <= INT8_MAX; sample_signed++)
+		{
+			while (i + 1 < POSITIVE_DELTAS_END
+			    && prev_sample_signed + gDeltaEncodingTable[i + 1] <= INT8_MAX
+			    && ABS(prev_sample_signed + gDeltaEncodingTable[i + 1] - sample_signed) < ABS(prev_sample_signed + gDeltaEncodingTable[i] - sample_signed))
+			{
+				i++;
+			}
+			row[(uint8_t)sample_signed] = i;
+		}
+
+		// Ties go to the lower index, so step down on equal error here.
+		i = NEGATIVE_DELTAS_END - 1;
+		for (int sample_signed = prev_sample_signed - 1; sample_signed >= INT8_MIN; sample_signed--)
+		{
+			while (i - 1 >= NEGATIVE_DELTAS_START
+			    && prev_sample_signed + gDeltaEncodingTable[i - 1] >= INT8_MIN
+			    && ABS(prev_sample_signed + gDeltaEncodingTable[i - 1] - sample_signed) <= ABS(prev_sample_signed + gDeltaEncodingTable[i] - sample_signed))
+			{
+				i--;
+			}
+			row[(uint8_t)sample_signed] = i;
+		}
+	}
+}
+
+#define DELTA_BLOCK_SIZE 64
+
+// Picks the delta index for each sample of a block the same way the
+// original compressor does: the closest delta in the direction the
+// samples are moving, from the value decoded so far.
+void greedy_delta_block(const uint8_t *samples, int count, uint8_t *indices)
+{
+	uint8_t base = samples[0];
+
+	for (int i = 1; i < count; i++)
+	{
+		indices[i] = gDeltaIndexTable[base][samples[i]];
+		base += gDeltaEncodingTable[indices[i]];
+	}
+}
+
+int sample_error(uint8_t decoded, uint8_t sample)
+{
+	int difference = U8_TO_S8(decoded) - U8_TO_S8(sample);
+	return difference * difference;
+}
+
+// Picks the delta indices for a block that minimize the total squared
+// error of the decoded samples, with a Viterbi search over the 256 values
+// the decoder can hold. A path can only get worse, so any that are already
+// worse than the greedy encoding of the block are dropped. This keeps the
+// search small without losing the best path.
+void trellis_delta_block(const uint8_t *samples, int count, uint8_t *indices)
+{
+	int cost[256];
+	int next_cost[256];
+	uint8_t choice[DELTA_BLOCK_SIZE][256];
+
+	greedy_delta_block(samples, count, indices);
+	int bound = 0;
+	uint8_t base = samples[0];
+	for (int i = 1; i < count; i++)
+	{
+		base += gDeltaEncodingTable[indices[i]];
+		bound += sample_error(base, samples[i]);
+	}
+
+	for (int value = 0; value < 256; value++)
+	{
+		cost[value] = INT_MAX;
+	}
+	cost[samples[0]] = 0;
+
+	for (int i = 1; i < count; i++)
+	{
+		for (int value = 0; value < 256; value++)
+		{
+			next_cost[value] = INT_MAX;
+		}
+
+		for (int value = 0; value < 256; value++)
+		{
+			if (cost[value] > bound)
+			{
+				continue;
+			}
+			for (int delta_index = 0; delta_index < NEGATIVE_DELTAS_END; delta_index++)
+			{
+				uint8_t new_value = value + gDeltaEncodingTable[delta_index];
+				int new_cost = cost[value] + sample_error(new_value, samples[i]);
+				if (new_cost <= bound && new_cost < next_cost[new_value])
+				{
+					next_cost[new_value] = new_cost;
+					choice[i][new_value] = delta_index;
+				}
+			}
+		}
+
+		memcpy(cost, next_cost, sizeof(cost));
+	}
+
+	int best_value = 0;
+	for (int value = 1; value < 256; value++)
+	{
+		if (cost[value] < cost[best_value])
+		{
+			best_value = value;
+		}
+	}
+
+	for (int i = count - 1; i >= 1; i--)
+	{
+		indices[i] = choice[i][best_value];
+		best_value = (uint8_t)(best_value - gDeltaEncodingTable[indices[i]]);
+	}
+}
+
+// Writes one block: the first sample as-is, the second sample's delta
+// index in a byte of its own, then the rest two to a byte, high nibble first.
+unsigned int pack_delta_block(uint8_t *dest, const uint8_t *samples, const uint8_t *indices, int count)
+{
+	unsigned int j = 0;
+	int i = 0;
+
+	dest[j++] = samples[i++];
+	if (i >= count)
+	{
+		return j;
+	}
+	dest[j++] = indices[i++];
+
+	while (i < count)
+	{
+		dest[j] = indices[i++] << 4;
+		// A final lone high nibble has never been counted in the output.
+		if (i >= count)
+		{
+			break;
+		}
+		dest[j++] |= indices[i++];
+	}
+
+	return j;
+}
+
+struct Bytes *delta_compress(struct Bytes *pcm, bool trellis)
 {
 	struct Bytes *delta = malloc(sizeof(struct Bytes));
 	// estimate the length so we can malloc
@@ -509,41 +824,22 @@ struct Bytes *delta_compress(struct Bytes *pcm)
 
 	unsigned int i = 0;
 	unsigned int j = 0;
-	int k;
-	uint8_t base;
-	int delta_index;
+	uint8_t indices[DELTA_BLOCK_SIZE];
 
 	while (i < pcm->length)
 	{
-		base = pcm->data[i++];
-		delta->data[j++] = base;
+		int count = pcm->length - i < DELTA_BLOCK_SIZE ? pcm->length - i : DELTA_BLOCK_SIZE;
 
-		if (i >= pcm->length)
+		if (trellis)
 		{
-			break;
+			trellis_delta_block(&pcm->data[i], count, indices);
 		}
-		delta_index = get_delta_index(pcm->data[i++], base);
-		base += gDeltaEncodingTable[delta_index];
-		delta->data[j++] = delta_index;
-
-		for (k = 0; k < 31; k++)
+		else
 		{
-			if (i >= pcm->length)
-			{
-				break;
-			}
-			delta_index = get_delta_index(pcm->data[i++], base);
-			base += gDeltaEncodingTable[delta_index];
-			delta->data[j] = (delta_index << 4);
-
-			if (i >= pcm->length)
-			{
-				break;
-			}
-			delta_index = get_delta_index(pcm->data[i++], base);
-			base += gDeltaEncodingTable[delta_index];
-			delta->data[j++] |= delta_index;
+			greedy_delta_block(&pcm->data[i], count, indices);
 		}
+		j += pack_delta_block(&delta->data[j], &pcm->data[i], indices, count);
+		i += count;
 	}
 
 	delta->length = j;
@@ -551,6 +847,31 @@ struct Bytes *delta_compress(struct Bytes *pcm)
 	return delta;
 }
 
+// Signal-to-noise ratio in dB of the decompressed samples against the source.
+double delta_snr(struct Bytes *pcm, struct Bytes *delta)
+{
+	struct Bytes *decoded = delta_decompress(delta, pcm->length);
+	double signal = 0;
+	double noise = 0;
+
+	for (unsigned long i = 0; i < decoded->length; i++)
+	{
+		int sample = U8_TO_S8(pcm->data[i]);
+		int error = U8_TO_S8(decoded->data[i]) - sample;
+		signal += sample * sample;
+		noise += error * error;
+	}
+
+	free(decoded->data);
+	free(decoded);
+
+	if (noise == 0)
+	{
+		return INFINITY;
+	}
+	return 10 * log10(signal / noise);
+}
+
 #define STORE_U32_LE(dest, value) \
 do { \
 	*(dest) = (value) & 0xff; \
@@ -567,36 +888,253 @@ do { \
 	(var) |= (*((src) + 3) << 24); \
 } while (0)
 
+#define RESAMPLE_PHASES 256
+#define RESAMPLE_ZERO_CROSSINGS 16
+#define RESAMPLE_ROLLOFF 0.92
+#define RESAMPLE_KAISER_BETA 8.0
+
+#define PI 3.14159265358979323846
+
+double bessel_i0(double x)
+{
+	double sum = 1;
+	double term = 1;
+
+	for (int k = 1; k < 32; k++)
+	{
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+// A sample of the source, running on through the loop past its end so
+// the filter doesn't see a cliff at the loop point.
+float sample_at(const float *samples, unsigned long length, const AifData *aif_data, long k)
+{
+	if (k < 0)
+	{
+		return 0;
+	}
+	if (aif_data->has_loop && (unsigned long)k >= aif_data->num_samples && aif_data->num_samples > aif_data->loop_offset)
+	{
+		k = aif_data->loop_offset + (k - aif_data->loop_offset) % (aif_data->num_samples - aif_data->loop_offset);
+	}
+	if ((unsigned long)k >= length)
+	{
+		return 0;
+	}
+	return samples[k];
+}
+
+// Resamples by ratio with a Kaiser-windowed sinc filter. The filter is
+// tabulated at RESAMPLE_PHASES fractional offsets, and each output sample
+// interpolates between the two phases either side of its position. When
+// downsampling, the filter is stretched so that it cuts off below the new
+// Nyquist frequency.
+float *resample(const float *samples, unsigned long length, const AifData *aif_data, double ratio, unsigned long new_length)
+{
+	double scale = ratio < 1 ? ratio : 1;
+	double cutoff = scale * RESAMPLE_ROLLOFF;
+	int half_taps = (int)ceil(RESAMPLE_ZERO_CROSSINGS / scale);
+	int taps = 2 * half_taps;
+	float *kernel = malloc((RESAMPLE_PHASES + 1) * taps * sizeof(float));
+	double window_scale = 1 / bessel_i0(RESAMPLE_KAISER_BETA);
+
+	// kernel[phase][i] weighs source sample floor(t) - half_taps + 1 + i
+	// for an output position t with fractional part phase / RESAMPLE_PHASES.
+	for (int phase = 0; phase <= RESAMPLE_PHASES; phase++)
+	{
+		for (int i = 0; i < taps; i++)
+		{
+			double offset = (double)phase / RESAMPLE_PHASES + half_taps - 1 - i;
+			double x = offset / half_taps;
+			double value = 0;
+			if (x > -1 && x < 1)
+			{
+				double sinc = offset == 0 ? 1 : sin(PI * cutoff * offset) / (PI * cutoff * offset);
+				value = cutoff * sinc * bessel_i0(RESAMPLE_KAISER_BETA * sqrt(1 - x * x)) * window_scale;
+			}
+			kernel[phase * taps + i] = value;
+		}
+	}
+
+	float *resampled = malloc(new_length * sizeof(float));
+
+	for (unsigned long n = 0; n < new_length; n++)
+	{
+		double position = n / ratio;
+		long base = (long)floor(position);
+		double phase_position = (position - base) * RESAMPLE_PHASES;
+		int phase = (int)phase_position;
+		double blend = phase_position - phase;
+		const float *kernel_a = &kernel[phase * taps];
+		const float *kernel_b = &kernel[(phase + 1) * taps];
+		long first = base - half_taps + 1;
+		double sum = 0;
+
+		for (int i = 0; i < taps; i++)
+		{
+			double weight = kernel_a[i] + (kernel_b[i] - kernel_a[i]) * blend;
+			sum += weight * sample_at(samples, length, aif_data, first + i);
+		}
+		resampled[n] = sum;
+	}
+
+	free(kernel);
+	return resampled;
+}
+
+// An optional stage that replaces the plain truncation to 8 bits. It can
+// resample to options->rate, scale the peak to full scale, and add
+// triangular dither before rounding. The dither comes from a fixed seed so
+// builds stay reproducible.
+void condition_samples(AifData *aif_data, const struct ConvertOptions *options)
+{
+	unsigned long length = aif_data->real_num_samples;
+	if (aif_data->sample_size == 16)
+	{
+		length /= 2;
+	}
+
+	float *samples = malloc((length ? length : 1) * sizeof(float));
+	for (unsigned long i = 0; i < length; i++)
+	{
+		if (aif_data->sample_size == 16)
+		{
+			samples[i] = (int16_t)aif_data->samples16[i] / 32768.0f;
+		}
+		else
+		{
+			samples[i] = (int8_t)aif_data->samples8[i] / 128.0f;
+		}
+	}
+	free(aif_data->samples8);
+
+	if (options->rate > 0 && options->rate != aif_data->sample_rate)
+	{
+		double ratio = options->rate / aif_data->sample_rate;
+		unsigned long new_length = (unsigned long)(length * ratio + 0.5);
+		float *resampled = resample(samples, length, aif_data, ratio, new_length);
+		free(samples);
+		samples = resampled;
+		length = new_length;
+
+		aif_data->loop_offset = (unsigned long)(aif_data->loop_offset * ratio + 0.5);
+		aif_data->num_samples = (unsigned long)(aif_data->num_samples * ratio + 0.5);
+		if (aif_data->num_samples > length)
+		{
+			aif_data->num_samples = length;
+		}
+		if (aif_data->num_samples == 0)
+		{
+			aif_data->num_samples = 1;
+		}
+		aif_data->sample_rate = options->rate;
+	}
+
+	double gain = 1;
+	if (options->normalize)
+	{
+		float peak = 0;
+		for (unsigned long i = 0; i < length; i++)
+		{
+			if (fabsf(samples[i]) > peak)
+			{
+				peak = fabsf(samples[i]);
+			}
+		}
+		if (peak > 0)
+		{
+			gain = (127.0 / 128.0) / peak;
+		}
+	}
+
+	uint8_t *converted_samples = malloc(length ? length : 1);
+	uint32_t seed = 0x12345678;
+	for (unsigned long i = 0; i < length; i++)
+	{
+		double value = samples[i] * gain * 128;
+		if (options->dither)
+		{
+			// xorshift32, two draws summed for a triangular distribution
+			double noise = 0;
+			for (int j = 0; j < 2; j++)
+			{
+				seed ^= seed << 13;
+				seed ^= seed >> 17;
+				seed ^= seed << 5;
+				noise += seed / 4294967296.0 - 0.5;
+			}
+			value += noise;
+		}
+		value = floor(value + 0.5);
+		if (value > 127)
+		{
+			value = 127;
+		}
+		else if (value < -128)
+		{
+			value = -128;
+		}
+		converted_samples[i] = (uint8_t)(int8_t)value;
+	}
+	free(samples);
+
+	aif_data->samples8 = converted_samples;
+	aif_data->real_num_samples = length;
+	aif_data->sample_size = 8;
+}
+
 // Reads an .aif file and produces a .pcm file containing an array of 8-bit samples.
-void aif2pcm(const char *aif_filename, const char *pcm_filename, bool compress)
+// Reads an .aif and leaves its samples in aif_data->samples8 as 8 bits,
+// conditioned as the options ask.
+void read_aif_samples8(const char *aif_filename, const struct ConvertOptions *options, AifData *aif_data)
 {
-	struct Bytes *aif = read_bytearray(aif_filename);
-	AifData aif_data = {0};
-	read_aif(aif, &aif_data);
-	
+	struct Bytes *aif = map_bytearray(aif_filename);
+	read_aif(aif, aif_data);
+	unmap_bytearray(aif);
+
+	if (options->rate > 0 || options->normalize || options->dither)
+	{
+		condition_samples(aif_data, options);
+	}
 	// Convert 16-bit to 8-bit if necessary
-	if (aif_data.sample_size == 16)
+	else if (aif_data->sample_size == 16)
 	{
-		aif_data.real_num_samples /= 2;
-		uint8_t *converted_samples = malloc(aif_data.real_num_samples * sizeof(uint8_t));
-		for (unsigned long i = 0; i < aif_data.real_num_samples; i++)
+		aif_data->real_num_samples /= 2;
+		uint8_t *converted_samples = malloc(aif_data->real_num_samples * sizeof(uint8_t));
+		for (unsigned long i = 0; i < aif_data->real_num_samples; i++)
 		{
-			converted_samples[i] = aif_data.samples16[i] >> 8;
+			converted_samples[i] = aif_data->samples16[i] >> 8;
 		}
-		free(aif_data.samples16);
-		aif_data.samples8 = converted_samples;
+		free(aif_data->samples16);
+		aif_data->samples8 = converted_samples;
 	}
+}
+
+void aif2pcm(const char *aif_filename, const char *pcm_filename, const struct ConvertOptions *options)
+{
+	AifData aif_data = {0};
+	read_aif_samples8(aif_filename, options, &aif_data);
 
 	int header_size = 0x10;
 	struct Bytes *pcm;
 	struct Bytes output = {0,0};
 
-	if (compress)
+	if (options->compress)
 	{
 		struct Bytes *input = malloc(sizeof(struct Bytes));
 		input->data = aif_data.samples8;
 		input->length = aif_data.real_num_samples;
-		pcm = delta_compress(input);
+		pcm = delta_compress(input, options->trellis);
+		if (options->trellis)
+		{
+			struct Bytes *greedy = delta_compress(input, false);
+			printf("%s: SNR %.2f dB (greedy %.2f dB)\n", aif_filename, delta_snr(input, pcm), delta_snr(input, greedy));
+			free(greedy->data);
+			free(greedy);
+		}
 		free(input);
 	}
 	else
@@ -613,7 +1151,7 @@ void aif2pcm(const char *aif_filename, const char *pcm_filename, bool compress)
 	uint32_t adjusted_num_samples = (uint32_t)(aif_data.num_samples - 1);
 	uint32_t flags = 0;
 	if (aif_data.has_loop) flags |= 0x40000000;
-	if (compress) flags |= 1;
+	if (options->compress) flags |= 1;
 	STORE_U32_LE(output.data + 0, flags);
 	STORE_U32_LE(output.data + 4, pitch_adjust);
 	STORE_U32_LE(output.data + 8, loop_offset);
@@ -621,8 +1159,10 @@ void aif2pcm(const char *aif_filename, const char *pcm_filename, bool compress)
 	memcpy(&output.data[header_size], pcm->data, pcm->length);
 	write_bytearray(pcm_filename, &output);
 
-	free(aif->data);
-	free(aif);
+	if (options->compress)
+	{
+		free(pcm->data);
+	}
 	free(pcm);
 	free(output.data);
 	free(aif_data.samples8);
@@ -881,64 +1421,415 @@ void pcm2aif(const char *pcm_filename, const char *aif_filename, uint32_t base_n
 void usage(void)
 {
 	fprintf(stderr, "Usage: aif2pcm bin_file [aif_file]\n");
-	fprintf(stderr, "       aif2pcm aif_file [bin_file] [--compress]\n");
+	fprintf(stderr, "       aif2pcm aif_file [bin_file] [options]\n");
+	fprintf(stderr, "       aif2pcm --manifest manifest_file [--jobs n]\n");
+	fprintf(stderr, "       aif2pcm --bench [-n passes] [--trellis] aif_file...\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "Options for .aif files:\n");
+	fprintf(stderr, "  --compress   delta compress the samples\n");
+	fprintf(stderr, "  --trellis    with --compress, minimize the error of each block\n");
+	fprintf(stderr, "  --rate hz    resample to hz before converting to 8 bits\n");
+	fprintf(stderr, "  --normalize  scale the loudest sample to full scale\n");
+	fprintf(stderr, "  --dither     add triangular dither when converting to 8 bits\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "A manifest has one \"input_file output_file [options]\" per line. The\n");
+	fprintf(stderr, "files are converted by n threads (default: number of CPUs).\n");
+	fprintf(stderr, "\n");
+	fprintf(stderr, "--bench times delta compression of the .aif files, e.g. the cries in\n");
+	fprintf(stderr, "sound/direct_sound_samples/cries, over some passes (default: 20).\n");
 }
 
-int main(int argc, char **argv)
+// Fills in options from the arguments after the input and output files.
+// Anything unrecognized is ignored.
+void parse_options(char **args, int num_args, struct ConvertOptions *options)
 {
-	if (argc < 2)
+	memset(options, 0, sizeof(*options));
+
+	for (int i = 0; i < num_args; i++)
 	{
-		usage();
-		exit(1);
+		if (strcmp(args[i], "--compress") == 0)
+		{
+			options->compress = true;
+		}
+		else if (strcmp(args[i], "--trellis") == 0)
+		{
+			options->trellis = true;
+		}
+		else if (strcmp(args[i], "--rate") == 0)
+		{
+			char *end;
+			if (i + 1 >= num_args || (options->rate = strtod(args[i + 1], &end)) <= 0 || *end != '\0')
+			{
+				FATAL_ERROR("--rate needs a positive sample rate\n");
+			}
+			i++;
+		}
+		else if (strcmp(args[i], "--normalize") == 0)
+		{
+			options->normalize = true;
+		}
+		else if (strcmp(args[i], "--dither") == 0)
+		{
+			options->dither = true;
+		}
 	}
 
-	char *input_file = argv[1];
+	if (options->trellis && !options->compress)
+	{
+		FATAL_ERROR("--trellis only applies to --compress\n");
+	}
+}
+
+// Converts between .aif and .bin in whichever direction the input's
+// extension calls for.
+void convert(char *input_file, char *output_file, const struct ConvertOptions *options)
+{
 	char *extension = get_file_extension(input_file);
-	char *output_file;
-	bool compressed = false;
 
-	if (argc > 3)
+	if (extension && (strcmp(extension, "aif") == 0 || strcmp(extension, "aiff") == 0))
+	{
+		aif2pcm(input_file, output_file, options);
+	}
+	else if (extension && strcmp(extension, "bin") == 0)
+	{
+		pcm2aif(input_file, output_file, 60);
+	}
+	else
+	{
+		FATAL_ERROR("Input file must be .aif or .bin: '%s'\n", input_file);
+	}
+}
+
+// Splits the manifest into entries in place. Blank lines and anything
+// after a '#' are skipped.
+struct ManifestEntry *read_manifest(struct Bytes *manifest, int *num_entries)
+{
+	int capacity = 256;
+	struct ManifestEntry *entries = malloc(capacity * sizeof(struct ManifestEntry));
+	char *pos = (char *)manifest->data;
+	char *end = pos + manifest->length;
+	int line_num = 0;
+
+	*num_entries = 0;
+
+	while (pos < end)
+	{
+		char *line_end = memchr(pos, '\n', end - pos);
+		if (!line_end)
+		{
+			line_end = end;
+		}
+		*line_end = '\0';
+		line_num++;
+
+		char *comment = strchr(pos, '#');
+		if (comment)
+		{
+			*comment = '\0';
+		}
+
+		char *args[16];
+		int num_args = 0;
+		for (char *token = pos; *token; )
+		{
+			while (isspace((unsigned char)*token))
+			{
+				*token++ = '\0';
+			}
+			if (!*token)
+			{
+				break;
+			}
+			if (num_args == 16)
+			{
+				FATAL_ERROR("%s:%d: too many arguments\n", gManifestFilename, line_num);
+			}
+			args[num_args++] = token;
+			while (*token && !isspace((unsigned char)*token))
+			{
+				token++;
+			}
+		}
+		pos = line_end + 1;
+
+		if (num_args == 0)
+		{
+			continue;
+		}
+		if (num_args < 2)
+		{
+			FATAL_ERROR("%s:%d: expected an input and an output file\n", gManifestFilename, line_num);
+		}
+
+		if (*num_entries == capacity)
+		{
+			capacity *= 2;
+			entries = realloc(entries, capacity * sizeof(struct ManifestEntry));
+		}
+
+		struct ManifestEntry *entry = &entries[(*num_entries)++];
+		entry->line_num = line_num;
+		entry->input_file = args[0];
+		entry->output_file = args[1];
+		entry->error = NULL;
+		gThreadContext.entry = entry;
+		parse_options(&args[2], num_args - 2, &entry->options);
+		gThreadContext.entry = NULL;
+	}
+
+	return entries;
+}
+
+struct ManifestJobs {
+	struct ManifestEntry *entries;
+	int num_entries;
+	int next_entry;
+#ifndef _MSC_VER
+	pthread_mutex_t mutex;
+#endif
+};
+
+void *convert_manifest_entries(void *arg)
+{
+	struct ManifestJobs *jobs = arg;
+
+	for (;;)
+	{
+#ifndef _MSC_VER
+		pthread_mutex_lock(&jobs->mutex);
+#endif
+		int i = jobs->next_entry++;
+#ifndef _MSC_VER
+		pthread_mutex_unlock(&jobs->mutex);
+#endif
+		if (i >= jobs->num_entries)
+		{
+			break;
+		}
+
+		struct ManifestEntry *entry = &jobs->entries[i];
+		jmp_buf on_error;
+		gThreadContext.entry = entry;
+		if (setjmp(on_error) == 0)
+		{
+			gThreadContext.on_error = &on_error;
+			convert(entry->input_file, entry->output_file, &entry->options);
+		}
+		gThreadContext.on_error = NULL;
+		gThreadContext.entry = NULL;
+	}
+
+	return NULL;
+}
+
+// Converts every file listed in the manifest, spreading them over
+// num_threads threads. A file that fails doesn't stop the others; all
+// errors are reported once every thread is done.
+void convert_manifest(const char *manifest_filename, int num_threads)
+{
+	gManifestFilename = manifest_filename;
+	struct Bytes *manifest = read_bytearray(manifest_filename);
+	// Room for a terminator after a last line that doesn't end in a newline.
+	manifest->data = realloc(manifest->data, manifest->length + 1);
+
+	struct ManifestJobs jobs;
+	jobs.entries = read_manifest(manifest, &jobs.num_entries);
+	jobs.next_entry = 0;
+
+#ifdef _MSC_VER
+	(void)num_threads;
+	convert_manifest_entries(&jobs);
+#else
+	if (num_threads <= 0)
+	{
+#ifdef _SC_NPROCESSORS_ONLN
+		num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	}
+	if (num_threads <= 0)
+	{
+		num_threads = 1;
+	}
+	if (num_threads > jobs.num_entries)
+	{
+		num_threads = jobs.num_entries;
+	}
+
+	pthread_mutex_init(&jobs.mutex, NULL);
+	pthread_t *threads = malloc(num_threads * sizeof(pthread_t));
+	for (int i = 1; i < num_threads; i++)
 	{
-		for (int i = 3; i < argc; i++)
+		if (pthread_create(&threads[i], NULL, convert_manifest_entries, &jobs) != 0)
 		{
-			if (strcmp(argv[i], "--compress") == 0)
+			FATAL_ERROR("Failed to start a conversion thread!\n");
+		}
+	}
+	convert_manifest_entries(&jobs);
+	for (int i = 1; i < num_threads; i++)
+	{
+		pthread_join(threads[i], NULL);
+	}
+	free(threads);
+	pthread_mutex_destroy(&jobs.mutex);
+#endif
+
+	bool failed = false;
+	for (int i = 0; i < jobs.num_entries; i++)
+	{
+		struct ManifestEntry *entry = &jobs.entries[i];
+		if (entry->error)
+		{
+			fprintf(stderr, "%s:%d: %s: %s", manifest_filename, entry->line_num, entry->input_file, entry->error);
+			free(entry->error);
+			failed = true;
+		}
+	}
+
+	free(jobs.entries);
+	free_bytearray(manifest);
+
+	if (failed)
+	{
+		exit(1);
+	}
+}
+
+double seconds_now(void)
+{
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Loads the files up front, then times delta compressing all of them, so
+// only the compressor is measured.
+void bench_compress(char **files, int num_files, int passes, bool trellis)
+{
+	struct ConvertOptions options = {0};
+	struct Bytes *inputs = malloc(num_files * sizeof(struct Bytes));
+	unsigned long total_samples = 0;
+	unsigned long total_compressed = 0;
+
+	for (int i = 0; i < num_files; i++)
+	{
+		AifData aif_data = {0};
+		read_aif_samples8(files[i], &options, &aif_data);
+		inputs[i].data = aif_data.samples8;
+		inputs[i].length = aif_data.real_num_samples;
+		total_samples += inputs[i].length;
+	}
+
+	double start = seconds_now();
+	for (int pass = 0; pass < passes; pass++)
+	{
+		for (int i = 0; i < num_files; i++)
+		{
+			struct Bytes *delta = delta_compress(&inputs[i], trellis);
+			if (pass == 0)
 			{
-				compressed = true;
+				total_compressed += delta->length;
 			}
+			free(delta->data);
+			free(delta);
 		}
 	}
+	double elapsed = seconds_now() - start;
+
+	printf("%d files, %lu samples -> %lu bytes\n", num_files, total_samples, total_compressed);
+	printf("%s: %d passes in %.3f s, %.1f Msamples/s\n", trellis ? "trellis" : "greedy",
+		passes, elapsed, total_samples * (double)passes / elapsed / 1e6);
+
+	for (int i = 0; i < num_files; i++)
+	{
+		free(inputs[i].data);
+	}
+	free(inputs);
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+	{
+		usage();
+		exit(1);
+	}
 
-	if (strcmp(extension, "aif") == 0 || strcmp(extension, "aiff") == 0)
+	init_delta_index_table();
+
+	if (strcmp(argv[1], "--manifest") == 0)
 	{
-		if (argc >= 3)
+		int num_threads = 0;
+
+		if (argc == 5 && strcmp(argv[3], "--jobs") == 0)
 		{
-			output_file = argv[2];
-			aif2pcm(input_file, output_file, compressed);
+			num_threads = atoi(argv[4]);
 		}
-		else
+		else if (argc != 3)
 		{
-			output_file = new_file_extension(input_file, "bin");
-			aif2pcm(input_file, output_file, compressed);
-			free(output_file);
+			usage();
+			exit(1);
 		}
+
+		convert_manifest(argv[2], num_threads);
+		return 0;
 	}
-	else if (strcmp(extension, "bin") == 0)
+
+	if (strcmp(argv[1], "--bench") == 0)
 	{
-		if (argc >= 3)
+		int passes = 20;
+		bool trellis = false;
+		int i = 2;
+
+		for (; i < argc && argv[i][0] == '-'; i++)
 		{
-			output_file = argv[2];
-			pcm2aif(input_file, output_file, 60);
+			if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			{
+				passes = atoi(argv[++i]);
+			}
+			else if (strcmp(argv[i], "--trellis") == 0)
+			{
+				trellis = true;
+			}
+			else
+			{
+				usage();
+				exit(1);
+			}
 		}
-		else
+
+		if (i == argc || passes <= 0)
 		{
-			output_file = new_file_extension(input_file, "aif");
-			pcm2aif(input_file, output_file, 60);
-			free(output_file);
+			usage();
+			exit(1);
 		}
+
+		bench_compress(&argv[i], argc - i, passes, trellis);
+		return 0;
+	}
+
+	char *input_file = argv[1];
+	char *extension = get_file_extension(input_file);
+	char *output_file;
+	struct ConvertOptions options;
+
+	parse_options(&argv[3], argc > 3 ? argc - 3 : 0, &options);
+
+	if (argc >= 3)
+	{
+		convert(input_file, argv[2], &options);
 	}
 	else
 	{
-		FATAL_ERROR("Input file must be .aif or .bin: '%s'\n", input_file);
+		if (extension && strcmp(extension, "bin") == 0)
+		{
+			output_file = new_file_extension(input_file, "aif");
+		}
+		else
+		{
+			output_file = new_file_extension(input_file, "bin");
+		}
+		convert(input_file, output_file, &options);
+		free(output_file);
 	}
 
 	return 0;
@@ -1,11 +1,29 @@
 // Copyright (c) 2015 YamaArashi
 
 #include <stdio.h>
+#include <string.h>
 #include <setjmp.h>
 #include <png.h>
 #include "global.h"
 #include "convert_png.h"
 #include "gfx.h"
+#include "quantize.h"
+
+static void PngCreateReadStructs(png_structp *pngStruct, png_infop *pngInfo)
+{
+    png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+
+    if (!png_ptr)
+        FATAL_ERROR("Failed to create PNG read struct.\n");
+
+    png_infop info_ptr = png_create_info_struct(png_ptr);
+
+    if (!info_ptr)
+        FATAL_ERROR("Failed to create PNG info struct.\n");
+
+    *pngStruct = png_ptr;
+    *pngInfo = info_ptr;
+}
 
 static FILE *PngReadOpen(char *path, png_structp *pngStruct, png_infop *pngInfo)
 {
@@ -22,36 +40,59 @@ static FILE *PngReadOpen(char *path, png_structp *pngStruct, png_infop *pngInfo)
     if (png_sig_cmp(sig, 0, 8))
         FATAL_ERROR("\"%s\" does not have a valid PNG signature.\n", path);
 
-    png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    PngCreateReadStructs(pngStruct, pngInfo);
 
-    if (!png_ptr)
-        FATAL_ERROR("Failed to create PNG read struct.\n");
-
-    png_infop info_ptr = png_create_info_struct(png_ptr);
-
-    if (!info_ptr)
-        FATAL_ERROR("Failed to create PNG info struct.\n");
+    png_structp png_ptr = *pngStruct;
 
     if (setjmp(png_jmpbuf(png_ptr)))
         FATAL_ERROR("Failed to init I/O for reading \"%s\".\n", path);
 
     png_init_io(png_ptr, fp);
     png_set_sig_bytes(png_ptr, 8);
-    png_read_info(png_ptr, info_ptr);
-
-    *pngStruct = png_ptr;
-    *pngInfo = info_ptr;
+    png_read_info(png_ptr, *pngInfo);
 
     return fp;
 }
 
-static unsigned char *ConvertBitDepth(unsigned char *src, int srcBitDepth, int destBitDepth, int numPixels)
+struct PngBufferReader {
+    unsigned char *data;
+    int size;
+    int pos;
+};
+
+static void ReadPngFromBuffer(png_structp png_ptr, png_bytep dest, png_size_t count)
+{
+    struct PngBufferReader *reader = png_get_io_ptr(png_ptr);
+
+    if (count > (png_size_t)(reader->size - reader->pos))
+        png_error(png_ptr, "Unexpected end of PNG data");
+
+    memcpy(dest, &reader->data[reader->pos], count);
+    reader->pos += count;
+}
+
+static void PngReadOpenBuffer(struct PngBufferReader *reader, png_structp *pngStruct, png_infop *pngInfo)
+{
+    if (reader->size < 8 || png_sig_cmp(reader->data, 0, 8))
+        FATAL_ERROR("PNG data does not have a valid PNG signature.\n");
+
+    PngCreateReadStructs(pngStruct, pngInfo);
+
+    png_structp png_ptr = *pngStruct;
+
+    if (setjmp(png_jmpbuf(png_ptr)))
+        FATAL_ERROR("Failed to init I/O for reading PNG data.\n");
+
+    reader->pos = 8;
+    png_set_read_fn(png_ptr, reader, ReadPngFromBuffer);
+    png_set_sig_bytes(png_ptr, 8);
+    png_read_info(png_ptr, *pngInfo);
+}
+
+static void ConvertBitDepthInto(unsigned char *src, unsigned char *dest, int srcBitDepth, int destBitDepth, int numPixels)
 {
     // Round the number of bits up to the next 8 and divide by 8 to get the number of bytes.
     int srcSize = ((numPixels * srcBitDepth + 7) & ~7) / 8;
-    int destSize = ((numPixels * destBitDepth + 7) & ~7) / 8;
-    unsigned char *output = calloc(destSize, 1);
-    unsigned char *dest = output;
     int i;
     int j;
     int destBit = 8 - destBitDepth;
@@ -75,6 +116,14 @@ static unsigned char *ConvertBitDepth(unsigned char *src, int srcBitDepth, int d
             }
         }
     }
+}
+
+static unsigned char *ConvertBitDepth(unsigned char *src, int srcBitDepth, int destBitDepth, int numPixels)
+{
+    int destSize = ((numPixels * destBitDepth + 7) & ~7) / 8;
+    unsigned char *output = calloc(destSize, 1);
+
+    ConvertBitDepthInto(src, output, srcBitDepth, destBitDepth, numPixels);
 
     return output;
 }
@@ -137,6 +186,232 @@ void ReadPng(char *path, struct Image *image)
     }
 }
 
+// Reads the next numRows rows, or the whole image if numRows is 0.
+static void ReadPngRows(png_structp png_ptr, png_bytepp row_pointers, int numRows, char *path)
+{
+    if (setjmp(png_jmpbuf(png_ptr)))
+        FATAL_ERROR("Error reading from \"%s\".\n", path);
+
+    if (numRows == 0)
+        png_read_image(png_ptr, row_pointers);
+    else
+        png_read_rows(png_ptr, row_pointers, NULL, numRows);
+}
+
+static unsigned char *ReadPngRgba(png_structp png_ptr, png_infop info_ptr, int width, int height, char *path)
+{
+    png_set_expand(png_ptr);
+    png_set_strip_16(png_ptr);
+    png_set_gray_to_rgb(png_ptr);
+    png_set_add_alpha(png_ptr, 0xFF, PNG_FILLER_AFTER);
+    png_set_interlace_handling(png_ptr);
+    png_read_update_info(png_ptr, info_ptr);
+
+    unsigned char *pixels = malloc(height * width * 4);
+
+    if (pixels == NULL)
+        FATAL_ERROR("Failed to allocate pixel buffer.\n");
+
+    png_bytepp row_pointers = malloc(height * sizeof(png_bytep));
+
+    if (row_pointers == NULL)
+        FATAL_ERROR("Failed to allocate row pointers.\n");
+
+    for (int i = 0; i < height; i++)
+        row_pointers[i] = (png_bytep)(pixels + (i * width * 4));
+
+    ReadPngRows(png_ptr, row_pointers, 0, path);
+
+    free(row_pointers);
+
+    return pixels;
+}
+
+// Reduces a truecolor image to the output's palette size and returns one
+// palette index per pixel. With palette banks, the upper nybble of each index
+// selects the tile's palette the same way an 8bpp paletted image would.
+static unsigned char *QuantizePng(png_structp png_ptr, png_infop info_ptr, int width, int height, int bitDepth, int numPalettes, bool hasPaletteBanks, char *inputPath, struct Palette *palette)
+{
+    unsigned char *rgba = ReadPngRgba(png_ptr, info_ptr, width, height, inputPath);
+    unsigned char *indices = malloc(width * height);
+    unsigned char *tilePalettes = malloc((width / 8) * (height / 8));
+
+    if (indices == NULL || tilePalettes == NULL)
+        FATAL_ERROR("Failed to allocate pixel buffer.\n");
+
+    QuantizeImage(rgba, width, height, (1 << bitDepth) - 1, numPalettes, indices, tilePalettes, palette);
+
+    if (hasPaletteBanks)
+    {
+        for (int i = 0; i < width * height; i++)
+            indices[i] |= (15 - tilePalettes[(i / width / 8) * (width / 8) + (i % width) / 8]) << 4;
+    }
+
+    free(rgba);
+    free(tilePalettes);
+
+    return indices;
+}
+
+// Converts an opened PNG to tiles, writing them to outputPath, or to
+// output->tiles if outputPath is NULL. The tilemap, if generateTilemap is
+// set, goes to options->tilemapFilePath or output->tilemap the same way.
+// Truecolor images also leave their generated palette in output->palette.
+static void ConvertPngToTiles(png_structp png_ptr, png_infop info_ptr, char *inputPath, char *outputPath, struct PngToGbaOptions *options, bool generateTilemap, struct PngToGbaOutput *output)
+{
+    int bitDepth = options->bitDepth;
+
+    int bit_depth = png_get_bit_depth(png_ptr, info_ptr);
+
+    int color_type = png_get_color_type(png_ptr, info_ptr);
+
+    // Anything that isn't already palette indices or plain 1-8 bit gray is
+    // quantized, including gray with alpha and 16-bit gray.
+    bool truecolor = color_type != PNG_COLOR_TYPE_PALETTE
+        && (color_type != PNG_COLOR_TYPE_GRAY || bit_depth == 16);
+
+    if (outputPath != NULL && truecolor && options->paletteFilePath == NULL)
+        FATAL_ERROR("Truecolor images need \"-palette\" to write the generated palette to.\n");
+
+    if (outputPath != NULL && !truecolor && options->paletteFilePath != NULL)
+        FATAL_ERROR("\"-palette\" can only be used with truecolor images.\n");
+
+    int width = png_get_image_width(png_ptr, info_ptr);
+    int height = png_get_image_height(png_ptr, info_ptr);
+
+    // Interlaced rows only become final after the last pass, and truecolor
+    // images need every color before a palette can be chosen, so those
+    // images have to be decoded in full before any tiles can be written.
+    bool interlaced = png_get_interlace_type(png_ptr, info_ptr) != PNG_INTERLACE_NONE;
+
+    struct TileWriter writer;
+
+    InitTileWriter(&writer, outputPath, options->numTilesMode, options->numTiles, bitDepth, options->metatileWidth, options->metatileHeight, width, height, color_type == PNG_COLOR_TYPE_GRAY && !truecolor);
+
+    // An 8bpp paletted image converted to a 4bpp tilemap keeps its upper
+    // nybble, which the writer turns into each tile's palette number.
+    bool hasPaletteBanks = generateTilemap && bitDepth == 4
+        && ((bit_depth == 8 && color_type == PNG_COLOR_TYPE_PALETTE) || truecolor);
+
+    if (generateTilemap)
+        SetTileWriterTilemap(&writer, outputPath != NULL ? options->tilemapFilePath : NULL, options->isAffineMap, hasPaletteBanks);
+
+    int destBitDepth = hasPaletteBanks ? 8 : bitDepth;
+    int rowHeight = options->metatileHeight * 8;
+    unsigned char *image = NULL;
+    int rowbytes;
+
+    if (truecolor)
+    {
+        image = QuantizePng(png_ptr, info_ptr, width, height, bitDepth, options->numPalettes, hasPaletteBanks, inputPath, &output->palette);
+
+        if (outputPath != NULL)
+            WriteGbaPalette(options->paletteFilePath, &output->palette);
+        bit_depth = 8;
+        rowbytes = width;
+    }
+    else
+    {
+        rowbytes = png_get_rowbytes(png_ptr, info_ptr);
+    }
+
+    if (bit_depth != destBitDepth && bit_depth != 1 && bit_depth != 2 && bit_depth != 4 && bit_depth != 8)
+        FATAL_ERROR("Bit depth of image must be 1, 2, 4, or 8.\n");
+
+    int destRowSize = (width * destBitDepth / 8) * rowHeight;
+    int numRows = interlaced ? height : rowHeight;
+    png_bytepp row_pointers = NULL;
+
+    if (image == NULL)
+    {
+        image = malloc(numRows * rowbytes);
+
+        if (image == NULL)
+            FATAL_ERROR("Failed to allocate pixel buffer.\n");
+
+        row_pointers = malloc(numRows * sizeof(png_bytep));
+
+        if (row_pointers == NULL)
+            FATAL_ERROR("Failed to allocate row pointers.\n");
+
+        for (int i = 0; i < numRows; i++)
+            row_pointers[i] = (png_bytep)(image + (i * rowbytes));
+
+        if (interlaced)
+            ReadPngRows(png_ptr, row_pointers, 0, inputPath);
+    }
+
+    unsigned char *converted = NULL;
+
+    if (bit_depth != destBitDepth)
+    {
+        converted = malloc(destRowSize);
+
+        if (converted == NULL)
+            FATAL_ERROR("Failed to allocate pixel buffer.\n");
+    }
+
+    for (int y = 0; y < height; y += rowHeight)
+    {
+        unsigned char *src = image;
+
+        if (row_pointers == NULL || interlaced)
+            src += y * rowbytes;
+        else
+            ReadPngRows(png_ptr, row_pointers, rowHeight, inputPath);
+
+        if (converted != NULL)
+        {
+            memset(converted, 0, destRowSize);
+            ConvertBitDepthInto(src, converted, bit_depth, destBitDepth, width * rowHeight);
+            src = converted;
+        }
+
+        WriteTileRow(&writer, src);
+    }
+
+    FinishTileWriter(&writer);
+
+    output->tiles = writer.tiles;
+    output->tilemap = writer.tilemap;
+
+    free(converted);
+    free(image);
+    free(row_pointers);
+}
+
+void StreamPngToTiles(char *inputPath, char *outputPath, struct PngToGbaOptions *options)
+{
+    png_structp png_ptr;
+    png_infop info_ptr;
+    struct PngToGbaOutput output;
+
+    FILE *fp = PngReadOpen(inputPath, &png_ptr, &info_ptr);
+
+    ConvertPngToTiles(png_ptr, info_ptr, inputPath, outputPath, options, options->tilemapFilePath != NULL, &output);
+
+    png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
+
+    fclose(fp);
+}
+
+// In-memory counterpart of StreamPngToTiles. The caller owns and frees
+// output->tiles.data and output->tilemap.data. File paths in options are ignored.
+void ConvertPngBufferToTiles(unsigned char *png, int pngSize, struct PngToGbaOptions *options, bool generateTilemap, struct PngToGbaOutput *output)
+{
+    png_structp png_ptr;
+    png_infop info_ptr;
+    struct PngBufferReader reader = { png, pngSize, 0 };
+
+    PngReadOpenBuffer(&reader, &png_ptr, &info_ptr);
+
+    output->palette.numColors = 0;
+
+    ConvertPngToTiles(png_ptr, info_ptr, "PNG data", NULL, options, generateTilemap, output);
+
+    png_destroy_read_struct(&png_ptr, &info_ptr, NULL);
+}
+
 void ReadPngPalette(char *path, struct Palette *palette)
 {
     png_structp png_ptr;
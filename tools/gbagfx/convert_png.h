@@ -4,8 +4,17 @@
 #define CONVERT_PNG_H
 
 #include "gfx.h"
+#include "options.h"
+
+struct PngToGbaOutput {
+    struct Buffer tiles;
+    struct Buffer tilemap;
+    struct Palette palette;
+};
 
 void ReadPng(char *path, struct Image *image);
+void StreamPngToTiles(char *inputPath, char *outputPath, struct PngToGbaOptions *options);
+void ConvertPngBufferToTiles(unsigned char *png, int pngSize, struct PngToGbaOptions *options, bool generateTilemap, struct PngToGbaOutput *output);
 void WritePng(char *path, struct Image *image);
 void ReadPngPalette(char *path, struct Palette *palette);
 
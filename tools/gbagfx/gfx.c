@@ -397,18 +397,39 @@ void ReadImage(char *path, int tilesWidth, int bitDepth, int metatileWidth, int
 	free(buffer);
 }
 
-void WriteImage(char *path, enum NumTilesMode numTilesMode, int numTiles, int bitDepth, int metatileWidth, int metatileHeight, struct Image *image, bool invertColors)
+static const unsigned char sZeroTile[64];
+
+// The output is written while the input is still being decoded, so a fatal
+// error partway through would otherwise leave a truncated file behind.
+static struct TileWriter *sActiveTileWriter;
+
+static void RemoveIncompleteOutput(void)
 {
-	int tileSize = bitDepth * 8;
+	if (sActiveTileWriter != NULL) {
+		fclose(sActiveTileWriter->fp);
+		remove(sActiveTileWriter->path);
+		if (sActiveTileWriter->tilemapFp != NULL) {
+			fclose(sActiveTileWriter->tilemapFp);
+			remove(sActiveTileWriter->tilemapPath);
+		}
+	}
+}
 
-	if (image->width % 8 != 0)
-		FATAL_ERROR("The width in pixels (%d) isn't a multiple of 8.\n", image->width);
+static bool IsZeroTile(unsigned char *tile, int tileSize)
+{
+	return memcmp(tile, sZeroTile, tileSize) == 0;
+}
+
+void InitTileWriter(struct TileWriter *writer, char *path, enum NumTilesMode numTilesMode, int numTiles, int bitDepth, int metatileWidth, int metatileHeight, int width, int height, bool invertColors)
+{
+	if (width % 8 != 0)
+		FATAL_ERROR("The width in pixels (%d) isn't a multiple of 8.\n", width);
 
-	if (image->height % 8 != 0)
-		FATAL_ERROR("The height in pixels (%d) isn't a multiple of 8.\n", image->height);
+	if (height % 8 != 0)
+		FATAL_ERROR("The height in pixels (%d) isn't a multiple of 8.\n", height);
 
-	int tilesWidth = image->width / 8;
-	int tilesHeight = image->height / 8;
+	int tilesWidth = width / 8;
+	int tilesHeight = height / 8;
 
 	if (tilesWidth % metatileWidth != 0)
 		FATAL_ERROR("The width in tiles (%d) isn't a multiple of the specified metatile width (%d)", tilesWidth, metatileWidth);
@@ -423,49 +444,313 @@ void WriteImage(char *path, enum NumTilesMode numTilesMode, int numTiles, int bi
 	else if (numTiles > maxNumTiles)
 		FATAL_ERROR("The specified number of tiles (%d) is greater than the maximum possible value (%d).\n", numTiles, maxNumTiles);
 
-	int bufferSize = numTiles * tileSize;
-	int maxBufferSize = maxNumTiles * tileSize;
-	unsigned char *buffer = malloc(maxBufferSize);
-
-	if (buffer == NULL)
+	writer->path = path;
+	writer->numTilesMode = numTilesMode;
+	writer->numTiles = numTiles;
+	writer->bitDepth = bitDepth;
+	writer->tileSize = bitDepth * 8;
+	writer->metatileWidth = metatileWidth;
+	writer->metatileHeight = metatileHeight;
+	writer->metatilesWide = tilesWidth / metatileWidth;
+	writer->tilesPerRow = tilesWidth * metatileHeight;
+	writer->invertColors = invertColors;
+	writer->tilesDone = 0;
+	writer->pendingZeroTiles = 0;
+	writer->zeroPadded = true;
+	writer->buffer = malloc(writer->tilesPerRow * writer->tileSize);
+	writer->tiles = (struct Buffer){ NULL, 0, 0 };
+	writer->hasTilemap = false;
+	writer->tilemapFp = NULL;
+	writer->tilemap = (struct Buffer){ NULL, 0, 0 };
+	writer->isAffine = false;
+	writer->hasPaletteBanks = false;
+	writer->uniqueTiles = NULL;
+	writer->tileHashTable = NULL;
+
+	if (writer->buffer == NULL)
 		FATAL_ERROR("Failed to allocate memory for pixels.\n");
 
-	int metatilesWide = tilesWidth / metatileWidth;
+	// Without a path the tiles are collected in writer->tiles instead.
+	if (path == NULL) {
+		writer->fp = NULL;
+		return;
+	}
 
-	switch (bitDepth) {
+	writer->fp = fopen(path, "wb");
+
+	if (writer->fp == NULL)
+		FATAL_ERROR("Failed to open \"%s\" for writing.\n", path);
+
+	static bool registered = false;
+
+	if (!registered) {
+		atexit(RemoveIncompleteOutput);
+		registered = true;
+	}
+
+	sActiveTileWriter = writer;
+}
+
+static void WriteTiles(struct TileWriter *writer, const unsigned char *tiles, int count)
+{
+	if (writer->fp == NULL)
+		AppendToBuffer(&writer->tiles, tiles, count * writer->tileSize);
+	else if (count > 0 && fwrite(tiles, writer->tileSize, count, writer->fp) != count)
+		FATAL_ERROR("Failed to write to \"%s\".\n", writer->path);
+}
+
+// Makes the writer deduplicate tiles and emit a tilemap instead of writing
+// every tile. Without a path the tilemap is collected in writer->tilemap.
+// If hasPaletteBanks is set, the pixels passed to WriteTileRow
+// are 8bpp and the high nybble selects the palette, mirroring how
+// DecodeNonAffineTilemap expands a 4bpp tilemap with more than 16 colors.
+void SetTileWriterTilemap(struct TileWriter *writer, char *tilemapPath, bool isAffine, bool hasPaletteBanks)
+{
+	if (isAffine && writer->bitDepth != 8)
+		FATAL_ERROR("affine maps are necessarily 8bpp\n");
+
+	if (hasPaletteBanks && writer->bitDepth != 4)
+		FATAL_ERROR("Palette banks can only be used with 4bpp tiles.\n");
+
+	int tileSize = writer->tileSize;
+
+	writer->isAffine = isAffine;
+	writer->hasPaletteBanks = hasPaletteBanks;
+	writer->numUniqueTiles = 0;
+	writer->maxUniqueTiles = isAffine ? 256 : 1024;
+
+	if (hasPaletteBanks) {
+		free(writer->buffer);
+		writer->buffer = malloc(writer->tilesPerRow * 64);
+		if (writer->buffer == NULL)
+			FATAL_ERROR("Failed to allocate memory for pixels.\n");
+	}
+
+	writer->tileHashTableSize = 1;
+	while (writer->tileHashTableSize < writer->maxUniqueTiles * 2)
+		writer->tileHashTableSize <<= 1;
+
+	writer->uniqueTiles = malloc(writer->maxUniqueTiles * tileSize);
+	writer->tileHashTable = malloc(writer->tileHashTableSize * sizeof(int));
+
+	if (writer->uniqueTiles == NULL || writer->tileHashTable == NULL)
+		FATAL_ERROR("Failed to allocate memory for tilemap.\n");
+
+	for (int i = 0; i < writer->tileHashTableSize; i++)
+		writer->tileHashTable[i] = -1;
+
+	writer->hasTilemap = true;
+	writer->tilemapPath = tilemapPath;
+
+	if (tilemapPath == NULL)
+		return;
+
+	writer->tilemapFp = fopen(tilemapPath, "wb");
+
+	if (writer->tilemapFp == NULL)
+		FATAL_ERROR("Failed to open \"%s\" for writing.\n", tilemapPath);
+}
+
+static void WriteTilemapEntry(struct TileWriter *writer, unsigned short entry)
+{
+	unsigned char bytes[2] = { entry & 0xFF, entry >> 8 };
+	int size = writer->isAffine ? 1 : 2;
+
+	if (writer->tilemapFp == NULL)
+		AppendToBuffer(&writer->tilemap, bytes, size);
+	else if (fwrite(bytes, size, 1, writer->tilemapFp) != 1)
+		FATAL_ERROR("Failed to write to \"%s\".\n", writer->tilemapPath);
+}
+
+static unsigned int HashTile(const unsigned char *tile, int tileSize)
+{
+	// FNV-1a
+	unsigned int hash = 2166136261u;
+
+	for (int i = 0; i < tileSize; i++) {
+		hash ^= tile[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+// Returns the slot in the hash table where the tile is, or the empty slot where it belongs.
+static int FindTileSlot(struct TileWriter *writer, const unsigned char *tile)
+{
+	int tileSize = writer->tileSize;
+	int mask = writer->tileHashTableSize - 1;
+	int slot = HashTile(tile, tileSize) & mask;
+
+	while (writer->tileHashTable[slot] != -1
+	    && memcmp(&writer->uniqueTiles[writer->tileHashTable[slot] * tileSize], tile, tileSize) != 0)
+		slot = (slot + 1) & mask;
+
+	return slot;
+}
+
+static int PackPaletteBankTile(unsigned char *tile, unsigned char *dest, int tileIndex)
+{
+	int bank = tile[0] >> 4;
+
+	for (int i = 0; i < 64; i++) {
+		if ((tile[i] >> 4) != bank)
+			FATAL_ERROR("Tile %d uses colors from more than one palette.\n", tileIndex + 1);
+	}
+
+	for (int i = 0; i < 32; i++)
+		dest[i] = (tile[i * 2] & 0xF) | ((tile[i * 2 + 1] & 0xF) << 4);
+
+	return 15 - bank;
+}
+
+static void AddTileToTilemap(struct TileWriter *writer, unsigned char *tile, int palno, int tileIndex)
+{
+	int tileSize = writer->tileSize;
+	unsigned char flipped[64];
+	int slot = FindTileSlot(writer, tile);
+	int flip = 0;
+
+	// Affine maps have no flip bits, so only exact matches can be reused.
+	if (writer->tileHashTable[slot] == -1 && !writer->isAffine) {
+		for (flip = 1; flip < 4; flip++) {
+			memcpy(flipped, tile, tileSize);
+			if (flip & 1)
+				HflipTile(flipped, writer->bitDepth);
+			if (flip & 2)
+				VflipTile(flipped, writer->bitDepth);
+
+			int flippedSlot = FindTileSlot(writer, flipped);
+
+			if (writer->tileHashTable[flippedSlot] != -1) {
+				slot = flippedSlot;
+				break;
+			}
+		}
+
+		if (flip == 4)
+			flip = 0;
+	}
+
+	if (writer->tileHashTable[slot] == -1) {
+		if (writer->numUniqueTiles == writer->maxUniqueTiles)
+			FATAL_ERROR("Tile %d needs more than the %d unique tiles a tilemap can address.\n", tileIndex + 1, writer->maxUniqueTiles);
+
+		writer->tileHashTable[slot] = writer->numUniqueTiles;
+		memcpy(&writer->uniqueTiles[writer->numUniqueTiles * tileSize], tile, tileSize);
+		writer->numUniqueTiles++;
+		WriteTiles(writer, tile, 1);
+	}
+
+	int index = writer->tileHashTable[slot];
+
+	WriteTilemapEntry(writer, index | ((flip & 1) << 10) | ((flip >> 1) << 11) | (palno << 12));
+}
+
+// Converts one metatile row of pixels (metatileHeight * 8 pixel rows at the
+// writer's bit depth) to tiles and appends them to the output. Tiles past
+// numTiles are held back as long as they are blank, since they are only
+// written if a later tile turns out to be non-transparent (-Wnum_tiles).
+void WriteTileRow(struct TileWriter *writer, unsigned char *pixels)
+{
+	int tileSize = writer->tileSize;
+	unsigned char *tiles = writer->buffer;
+
+	switch (writer->hasPaletteBanks ? 8 : writer->bitDepth) {
 	case 1:
-		ConvertToTiles1Bpp(image->pixels, buffer, maxNumTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
+		ConvertToTiles1Bpp(pixels, tiles, writer->tilesPerRow, writer->metatilesWide, writer->metatileWidth, writer->metatileHeight, writer->invertColors);
 		break;
 	case 4:
-		ConvertToTiles4Bpp(image->pixels, buffer, maxNumTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
+		ConvertToTiles4Bpp(pixels, tiles, writer->tilesPerRow, writer->metatilesWide, writer->metatileWidth, writer->metatileHeight, writer->invertColors);
 		break;
 	case 8:
-		ConvertToTiles8Bpp(image->pixels, buffer, maxNumTiles, metatilesWide, metatileWidth, metatileHeight, invertColors);
+		ConvertToTiles8Bpp(pixels, tiles, writer->tilesPerRow, writer->metatilesWide, writer->metatileWidth, writer->metatileHeight, writer->invertColors);
 		break;
 	}
 
-	bool zeroPadded = true;
-	for (int i = bufferSize; i < maxBufferSize && zeroPadded; i++) {
-		if (buffer[i] != 0)
-		{
-			switch (numTilesMode)
-			{
-			case NUM_TILES_IGNORE:
-				break;
-			case NUM_TILES_WARN:
-				fprintf(stderr, "Ignoring -num_tiles %d because tile %d contains non-transparent pixels.\n", numTiles, 1 + i / tileSize);
-				zeroPadded = false;
-				break;
-			case NUM_TILES_ERROR:
-				FATAL_ERROR("Tile %d contains non-transparent pixels.\n", 1 + i / tileSize);
-				break;
+	if (writer->hasTilemap) {
+		for (int i = 0; i < writer->tilesPerRow; i++) {
+			int palno = 0;
+			unsigned char *tile = &tiles[i * tileSize];
+
+			if (writer->hasPaletteBanks) {
+				tile = &tiles[i * 64];
+				palno = PackPaletteBankTile(tile, tile, writer->tilesDone + i);
 			}
+
+			AddTileToTilemap(writer, tile, palno, writer->tilesDone + i);
 		}
+
+		writer->tilesDone += writer->tilesPerRow;
+		return;
 	}
 
-	WriteWholeFile(path, buffer, zeroPadded ? bufferSize : maxBufferSize);
+	int i = 0;
 
-	free(buffer);
+	if (writer->zeroPadded) {
+		i = writer->numTiles - writer->tilesDone;
+		if (i < 0)
+			i = 0;
+		else if (i > writer->tilesPerRow)
+			i = writer->tilesPerRow;
+
+		WriteTiles(writer, tiles, i);
+
+		for (; i < writer->tilesPerRow && writer->numTilesMode != NUM_TILES_IGNORE; i++) {
+			if (IsZeroTile(&tiles[i * tileSize], tileSize)) {
+				writer->pendingZeroTiles++;
+				continue;
+			}
+
+			if (writer->numTilesMode == NUM_TILES_ERROR)
+				FATAL_ERROR("Tile %d contains non-transparent pixels.\n", writer->tilesDone + i + 1);
+
+			fprintf(stderr, "Ignoring -num_tiles %d because tile %d contains non-transparent pixels.\n", writer->numTiles, writer->tilesDone + i + 1);
+			writer->zeroPadded = false;
+
+			for (; writer->pendingZeroTiles > 0; writer->pendingZeroTiles--)
+				WriteTiles(writer, sZeroTile, 1);
+			break;
+		}
+	}
+
+	if (!writer->zeroPadded)
+		WriteTiles(writer, &tiles[i * tileSize], writer->tilesPerRow - i);
+
+	writer->tilesDone += writer->tilesPerRow;
+}
+
+void FinishTileWriter(struct TileWriter *writer)
+{
+	sActiveTileWriter = NULL;
+
+	if (writer->fp != NULL)
+		fclose(writer->fp);
+	free(writer->buffer);
+	writer->buffer = NULL;
+
+	if (writer->hasTilemap) {
+		if (writer->tilemapFp != NULL)
+			fclose(writer->tilemapFp);
+		writer->tilemapFp = NULL;
+		free(writer->uniqueTiles);
+		free(writer->tileHashTable);
+	}
+}
+
+void WriteImage(char *path, enum NumTilesMode numTilesMode, int numTiles, int bitDepth, int metatileWidth, int metatileHeight, struct Image *image, bool invertColors)
+{
+	struct TileWriter writer;
+
+	InitTileWriter(&writer, path, numTilesMode, numTiles, bitDepth, metatileWidth, metatileHeight, image->width, image->height, invertColors);
+
+	int rowHeight = metatileHeight * 8;
+	int rowSize = (image->width * bitDepth / 8) * rowHeight;
+
+	for (int row = 0; row < image->height / rowHeight; row++)
+		WriteTileRow(&writer, image->pixels + row * rowSize);
+
+	FinishTileWriter(&writer);
 }
 
 void FreeImage(struct Image *image)
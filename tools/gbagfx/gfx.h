@@ -3,8 +3,10 @@
 #ifndef GFX_H
 #define GFX_H
 
+#include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "util.h"
 
 struct Color {
 	unsigned char red;
@@ -50,8 +52,42 @@ enum NumTilesMode {
     NUM_TILES_ERROR,
 };
 
+struct TileWriter {
+	FILE *fp;
+	char *path;
+	enum NumTilesMode numTilesMode;
+	int numTiles;
+	int bitDepth;
+	int tileSize;
+	int metatileWidth;
+	int metatileHeight;
+	int metatilesWide;
+	int tilesPerRow;
+	bool invertColors;
+	int tilesDone;
+	int pendingZeroTiles;
+	bool zeroPadded;
+	unsigned char *buffer;
+	struct Buffer tiles;
+	bool hasTilemap;
+	FILE *tilemapFp;
+	char *tilemapPath;
+	struct Buffer tilemap;
+	bool isAffine;
+	bool hasPaletteBanks;
+	unsigned char *uniqueTiles;
+	int numUniqueTiles;
+	int maxUniqueTiles;
+	int *tileHashTable;
+	int tileHashTableSize;
+};
+
 void ReadImage(char *path, int tilesWidth, int bitDepth, int metatileWidth, int metatileHeight, struct Image *image, bool invertColors);
 void WriteImage(char *path, enum NumTilesMode numTilesMode, int numTiles, int bitDepth, int metatileWidth, int metatileHeight, struct Image *image, bool invertColors);
+void InitTileWriter(struct TileWriter *writer, char *path, enum NumTilesMode numTilesMode, int numTiles, int bitDepth, int metatileWidth, int metatileHeight, int width, int height, bool invertColors);
+void SetTileWriterTilemap(struct TileWriter *writer, char *tilemapPath, bool isAffine, bool hasPaletteBanks);
+void WriteTileRow(struct TileWriter *writer, unsigned char *pixels);
+void FinishTileWriter(struct TileWriter *writer);
 void FreeImage(struct Image *image);
 void ReadGbaPalette(char *path, struct Palette *palette);
 void WriteGbaPalette(char *path, struct Palette *palette);
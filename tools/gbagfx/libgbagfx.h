@@ -0,0 +1,28 @@
+#ifndef LIBGBAGFX_H
+#define LIBGBAGFX_H
+
+// Entry point for using gbagfx's conversion and compression stages as a
+// library (libgbagfx.a), e.g. to chain them in memory from other tools.
+// Like the command-line tool, the library reports errors with FATAL_ERROR,
+// which exits the process.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "global.h"
+#include "util.h"
+#include "options.h"
+#include "gfx.h"
+#include "convert_png.h"
+#include "jasc_pal.h"
+#include "lz.h"
+#include "rl.h"
+#include "huff.h"
+#include "font.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBGBAGFX_H
@@ -70,16 +70,7 @@ void ConvertGbaToPng(char *inputPath, char *outputPath, struct GbaToPngOptions *
 
 void ConvertPngToGba(char *inputPath, char *outputPath, struct PngToGbaOptions *options)
 {
-    struct Image image;
-
-    image.bitDepth = options->bitDepth;
-    image.tilemap.data.affine = NULL; // initialize to NULL to avoid issues in FreeImage
-
-    ReadPng(inputPath, &image);
-
-    WriteImage(outputPath, options->numTilesMode, options->numTiles, options->bitDepth, options->metatileWidth, options->metatileHeight, &image, !image.hasPalette);
-
-    FreeImage(&image);
+    StreamPngToTiles(inputPath, outputPath, options);
 }
 
 void HandleGbaToPngCommand(char *inputPath, char *outputPath, int argc, char **argv)
@@ -186,6 +177,8 @@ void HandlePngToGbaCommand(char *inputPath, char *outputPath, int argc, char **a
     options.metatileHeight = 1;
     options.tilemapFilePath = NULL;
     options.isAffineMap = false;
+    options.paletteFilePath = NULL;
+    options.numPalettes = 1;
 
     for (int i = 3; i < argc; i++)
     {
@@ -236,12 +229,54 @@ void HandlePngToGbaCommand(char *inputPath, char *outputPath, int argc, char **a
             if (options.metatileHeight < 1)
                 FATAL_ERROR("metatile height must be positive.\n");
         }
+        else if (strcmp(option, "-tilemap") == 0)
+        {
+            if (i + 1 >= argc)
+                FATAL_ERROR("No tilemap value following \"-tilemap\".\n");
+            i++;
+            options.tilemapFilePath = argv[i];
+        }
+        else if (strcmp(option, "-affine") == 0)
+        {
+            options.isAffineMap = true;
+        }
+        else if (strcmp(option, "-palette") == 0)
+        {
+            if (i + 1 >= argc)
+                FATAL_ERROR("No palette file path following \"-palette\".\n");
+
+            i++;
+
+            options.paletteFilePath = argv[i];
+        }
+        else if (strcmp(option, "-num_palettes") == 0)
+        {
+            if (i + 1 >= argc)
+                FATAL_ERROR("No number of palettes following \"-num_palettes\".\n");
+
+            i++;
+
+            if (!ParseNumber(argv[i], NULL, 10, &options.numPalettes))
+                FATAL_ERROR("Failed to parse number of palettes.\n");
+
+            if (options.numPalettes < 1 || options.numPalettes > 16)
+                FATAL_ERROR("Number of palettes must be between 1 and 16.\n");
+        }
         else
         {
             FATAL_ERROR("Unrecognized option \"%s\".\n", option);
         }
     }
 
+    if (options.numPalettes > 1 && (options.tilemapFilePath == NULL || options.bitDepth != 4))
+        FATAL_ERROR("\"-num_palettes\" requires 4bpp output with \"-tilemap\".\n");
+
+    if (options.tilemapFilePath != NULL && options.numTiles != 0)
+        FATAL_ERROR("\"-num_tiles\" can't be used with \"-tilemap\".\n");
+
+    if (options.isAffineMap && options.tilemapFilePath == NULL)
+        FATAL_ERROR("\"-affine\" requires \"-tilemap\".\n");
+
     ConvertPngToGba(inputPath, outputPath, &options);
 }
 
@@ -457,14 +492,42 @@ void HandleLZDecompressCommand(char *inputPath, char *outputPath, int argc UNUSE
     free(uncompressedData);
 }
 
-void HandleRLCompressCommand(char *inputPath, char *outputPath, int argc UNUSED, char **argv UNUSED)
+void HandleRLCompressCommand(char *inputPath, char *outputPath, int argc, char **argv)
 {
+    bool verify = false;
+
+    for (int i = 3; i < argc; i++)
+    {
+        char *option = argv[i];
+
+        if (strcmp(option, "-verify") == 0)
+        {
+            verify = true;
+        }
+        else
+        {
+            FATAL_ERROR("Unrecognized option \"%s\".\n", option);
+        }
+    }
+
     int fileSize;
     unsigned char *buffer = ReadWholeFile(inputPath, &fileSize);
 
     int compressedSize;
     unsigned char *compressedData = RLCompress(buffer, fileSize, &compressedSize);
 
+    // Make sure the compressed data decompresses back to the input.
+    if (verify)
+    {
+        int uncompressedSize;
+        unsigned char *uncompressedData = RLDecompress(compressedData, compressedSize, &uncompressedSize);
+
+        if (uncompressedSize != fileSize || memcmp(uncompressedData, buffer, fileSize) != 0)
+            FATAL_ERROR("RL compressed data for \"%s\" does not decompress to the input.\n", inputPath);
+
+        free(uncompressedData);
+    }
+
     free(buffer);
 
     WriteWholeFile(outputPath, compressedData, compressedSize);
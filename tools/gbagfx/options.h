@@ -25,6 +25,8 @@ struct PngToGbaOptions {
     int metatileHeight;
     char *tilemapFilePath;
     bool isAffineMap;
+    char *paletteFilePath;
+    int numPalettes;
 };
 
 #endif // OPTIONS_H
@@ -0,0 +1,213 @@
+// Benchmarks the png -> 4bpp -> lz chain entirely in memory through
+// libgbagfx, so that only the conversion and compression work is timed.
+//
+// With -rl, benchmarks RL compression instead. Each argument is then an .rl
+// target, such as graphics/picture_frame/cool.4bpp.rl, and its source is
+// compressed and decompressed again. A .4bpp source that hasn't been built
+// yet is converted from its .png in memory first, without any options its
+// make rule may add.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "libgbagfx.h"
+
+struct InputFile
+{
+    char *path;
+    unsigned char *data;
+    int size;
+};
+
+static bool EndsWith(const std::string &s, const char *suffix)
+{
+    size_t length = std::strlen(suffix);
+    return s.size() >= length && s.compare(s.size() - length, length, suffix) == 0;
+}
+
+static bool FileExists(const std::string &path)
+{
+    FILE *fp = std::fopen(path.c_str(), "rb");
+
+    if (fp == NULL)
+        return false;
+
+    std::fclose(fp);
+    return true;
+}
+
+// Reads the data that the .rl target at path is made from.
+static void ReadRlSource(InputFile &input, PngToGbaOptions *options)
+{
+    std::string path = input.path;
+
+    if (EndsWith(path, ".rl"))
+        path.resize(path.size() - 3);
+
+    if (!FileExists(path) && EndsWith(path, ".4bpp"))
+    {
+        std::string pngPath = path.substr(0, path.size() - 5) + ".png";
+        int pngSize;
+        unsigned char *png = ReadWholeFile(&pngPath[0], &pngSize);
+        PngToGbaOutput output;
+
+        ConvertPngBufferToTiles(png, pngSize, options, false, &output);
+        std::free(png);
+
+        input.data = output.tiles.data;
+        input.size = output.tiles.size;
+        return;
+    }
+
+    input.data = ReadWholeFile(&path[0], &input.size);
+}
+
+static void RunRlBench(const std::vector<InputFile> &inputs, int iterations)
+{
+    typedef std::chrono::steady_clock Clock;
+    Clock::duration compressTime = Clock::duration::zero();
+    Clock::duration decompressTime = Clock::duration::zero();
+    long long sourceBytes = 0;
+    long long compressedBytes = 0;
+
+    for (int i = 0; i < iterations; i++)
+    {
+        for (const InputFile &input : inputs)
+        {
+            Clock::time_point start = Clock::now();
+            int compressedSize;
+            unsigned char *compressed = RLCompress(input.data, input.size, &compressedSize);
+            Clock::time_point compressedAt = Clock::now();
+            int uncompressedSize;
+            unsigned char *uncompressed = RLDecompress(compressed, compressedSize, &uncompressedSize);
+            Clock::time_point finished = Clock::now();
+
+            if (uncompressedSize != input.size || std::memcmp(uncompressed, input.data, input.size) != 0)
+                FATAL_ERROR("RL round trip of \"%s\" doesn't match the source.\n", input.path);
+
+            compressTime += compressedAt - start;
+            decompressTime += finished - compressedAt;
+            sourceBytes += input.size;
+            compressedBytes += compressedSize;
+
+            std::free(compressed);
+            std::free(uncompressed);
+        }
+    }
+
+    double compressMs = std::chrono::duration<double, std::milli>(compressTime).count();
+    double decompressMs = std::chrono::duration<double, std::milli>(decompressTime).count();
+    long long runs = (long long)iterations * inputs.size();
+
+    std::printf("%zu files, %d iterations\n", inputs.size(), iterations);
+    std::printf("rl compress:   %.3f ms total, %.4f ms per file\n", compressMs, compressMs / runs);
+    std::printf("rl decompress: %.3f ms total, %.4f ms per file\n", decompressMs, decompressMs / runs);
+    std::printf("%lld source bytes compressed to %lld bytes\n", sourceBytes / iterations, compressedBytes / iterations);
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = 100;
+    bool rl = false;
+    std::vector<InputFile> inputs;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-n") == 0)
+        {
+            if (i + 1 >= argc || !ParseNumber(argv[i + 1], NULL, 10, &iterations) || iterations < 1)
+                FATAL_ERROR("Expected a positive number of iterations following \"-n\".\n");
+            i++;
+        }
+        else if (std::strcmp(argv[i], "-rl") == 0)
+        {
+            rl = true;
+        }
+        else
+        {
+            InputFile input;
+            input.path = argv[i];
+            inputs.push_back(input);
+        }
+    }
+
+    if (inputs.empty())
+        FATAL_ERROR("Usage: pipeline_bench [-n ITERATIONS] PNG_PATH...\n"
+                    "       pipeline_bench -rl [-n ITERATIONS] RL_TARGET...\n");
+
+    PngToGbaOptions options;
+    options.numTiles = 0;
+    options.numTilesMode = NUM_TILES_IGNORE;
+    options.bitDepth = 4;
+    options.metatileWidth = 1;
+    options.metatileHeight = 1;
+    options.tilemapFilePath = NULL;
+    options.isAffineMap = false;
+    options.paletteFilePath = NULL;
+    options.numPalettes = 1;
+
+    for (InputFile &input : inputs)
+    {
+        if (rl)
+            ReadRlSource(input, &options);
+        else
+            input.data = ReadWholeFile(input.path, &input.size);
+    }
+
+    if (rl)
+    {
+        RunRlBench(inputs, iterations);
+
+        for (const InputFile &input : inputs)
+            std::free(input.data);
+
+        return 0;
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::duration convertTime = Clock::duration::zero();
+    Clock::duration compressTime = Clock::duration::zero();
+    long long tileBytes = 0;
+    long long compressedBytes = 0;
+
+    for (int i = 0; i < iterations; i++)
+    {
+        for (const InputFile &input : inputs)
+        {
+            PngToGbaOutput output;
+
+            Clock::time_point start = Clock::now();
+            ConvertPngBufferToTiles(input.data, input.size, &options, false, &output);
+            Clock::time_point converted = Clock::now();
+
+            int compressedSize;
+            unsigned char *compressed = LZCompress(output.tiles.data, output.tiles.size, &compressedSize, 2);
+            Clock::time_point finished = Clock::now();
+
+            convertTime += converted - start;
+            compressTime += finished - converted;
+            tileBytes += output.tiles.size;
+            compressedBytes += compressedSize;
+
+            std::free(output.tiles.data);
+            std::free(compressed);
+        }
+    }
+
+    double convertMs = std::chrono::duration<double, std::milli>(convertTime).count();
+    double compressMs = std::chrono::duration<double, std::milli>(compressTime).count();
+    long long runs = (long long)iterations * inputs.size();
+
+    std::printf("%zu files, %d iterations\n", inputs.size(), iterations);
+    std::printf("png -> 4bpp: %.3f ms total, %.4f ms per file\n", convertMs, convertMs / runs);
+    std::printf("4bpp -> lz:  %.3f ms total, %.4f ms per file\n", compressMs, compressMs / runs);
+    std::printf("%lld tile bytes compressed to %lld bytes\n", tileBytes / iterations, compressedBytes / iterations);
+
+    for (const InputFile &input : inputs)
+        std::free(input.data);
+
+    return 0;
+}
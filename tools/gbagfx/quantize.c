@@ -0,0 +1,400 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include "global.h"
+#include "gfx.h"
+#include "quantize.h"
+
+// Colors are quantized in the GBA's own 15-bit color space.
+#define NUM_GBA_COLORS 0x8000
+#define TRANSPARENT_COLOR 0xFFFF
+#define COLOR_COMPONENT(color, axis) (((color) >> ((axis) * 5)) & 0x1F)
+
+#define MAX_ITERATIONS 16
+
+struct ColorCount {
+    unsigned short color;
+    int count;
+};
+
+struct TileColors {
+    struct ColorCount *colors;
+    int numColors;
+};
+
+struct QuantPalette {
+    unsigned short colors[255];
+    int numColors;
+    short *nearest; // lazily filled color -> palette index table, -1 if not looked up yet
+};
+
+struct ColorBox {
+    int start;
+    int end;
+};
+
+static int sSortAxis;
+
+static int CompareColorComponent(const void *a, const void *b)
+{
+    const struct ColorCount *x = a;
+    const struct ColorCount *y = b;
+    int diff = COLOR_COMPONENT(x->color, sSortAxis) - COLOR_COMPONENT(y->color, sSortAxis);
+
+    return diff != 0 ? diff : x->color - y->color;
+}
+
+// Splits the weighted colors into at most maxColors boxes, always cutting the
+// box with the widest range at its weighted median, and stores the weighted
+// mean of each box in result. Returns the number of colors produced.
+static int MedianCut(struct ColorCount *entries, int numEntries, int maxColors, unsigned short *result)
+{
+    struct ColorBox *boxes = malloc(maxColors * sizeof(struct ColorBox));
+    int numBoxes = 0;
+
+    if (boxes == NULL)
+        FATAL_ERROR("Failed to allocate memory for color boxes.\n");
+
+    if (numEntries > 0) {
+        boxes[0].start = 0;
+        boxes[0].end = numEntries;
+        numBoxes = 1;
+    }
+
+    while (numBoxes < maxColors) {
+        int bestBox = -1;
+        int bestAxis = 0;
+        int bestRange = 0;
+
+        for (int i = 0; i < numBoxes; i++) {
+            for (int axis = 0; axis < 3; axis++) {
+                int min = 0x1F;
+                int max = 0;
+
+                for (int j = boxes[i].start; j < boxes[i].end; j++) {
+                    int value = COLOR_COMPONENT(entries[j].color, axis);
+                    if (value < min)
+                        min = value;
+                    if (value > max)
+                        max = value;
+                }
+
+                if (max - min > bestRange) {
+                    bestRange = max - min;
+                    bestBox = i;
+                    bestAxis = axis;
+                }
+            }
+        }
+
+        if (bestBox == -1)
+            break;
+
+        struct ColorBox *box = &boxes[bestBox];
+        long total = 0;
+        long sum = 0;
+        int split = box->end - 1;
+
+        sSortAxis = bestAxis;
+        qsort(&entries[box->start], box->end - box->start, sizeof(struct ColorCount), CompareColorComponent);
+
+        for (int j = box->start; j < box->end; j++)
+            total += entries[j].count;
+
+        for (int j = box->start; j < box->end - 1; j++) {
+            sum += entries[j].count;
+            if (sum * 2 >= total) {
+                split = j + 1;
+                break;
+            }
+        }
+
+        boxes[numBoxes].start = split;
+        boxes[numBoxes].end = box->end;
+        box->end = split;
+        numBoxes++;
+    }
+
+    for (int i = 0; i < numBoxes; i++) {
+        long total = 0;
+        long sums[3] = { 0, 0, 0 };
+
+        for (int j = boxes[i].start; j < boxes[i].end; j++) {
+            total += entries[j].count;
+            for (int axis = 0; axis < 3; axis++)
+                sums[axis] += (long)COLOR_COMPONENT(entries[j].color, axis) * entries[j].count;
+        }
+
+        result[i] = 0;
+        for (int axis = 0; axis < 3; axis++)
+            result[i] |= ((sums[axis] + total / 2) / total) << (axis * 5);
+    }
+
+    free(boxes);
+
+    return numBoxes;
+}
+
+static int ColorDistance(unsigned short a, unsigned short b)
+{
+    int distance = 0;
+
+    for (int axis = 0; axis < 3; axis++) {
+        int diff = COLOR_COMPONENT(a, axis) - COLOR_COMPONENT(b, axis);
+        distance += diff * diff;
+    }
+
+    return distance;
+}
+
+static int NearestColor(struct QuantPalette *palette, unsigned short color)
+{
+    if (palette->nearest[color] < 0) {
+        int best = 0;
+        int bestDistance = INT_MAX;
+
+        for (int i = 0; i < palette->numColors; i++) {
+            int distance = ColorDistance(color, palette->colors[i]);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = i;
+            }
+        }
+
+        palette->nearest[color] = best;
+    }
+
+    return palette->nearest[color];
+}
+
+static long TileError(struct TileColors *tile, struct QuantPalette *palette)
+{
+    long error = 0;
+
+    if (tile->numColors == 0)
+        return 0;
+
+    if (palette->numColors == 0)
+        return LONG_MAX;
+
+    for (int i = 0; i < tile->numColors; i++) {
+        unsigned short color = tile->colors[i].color;
+        int nearest = NearestColor(palette, color);
+        error += (long)ColorDistance(color, palette->colors[nearest]) * tile->colors[i].count;
+    }
+
+    return error;
+}
+
+static void BuildPalette(struct QuantPalette *palette, struct TileColors *tiles, unsigned char *tilePalettes, int numTiles, int paletteNum, int colorsPerPalette, int *counts, struct ColorCount *entries)
+{
+    int numEntries = 0;
+
+    for (int i = 0; i < numTiles; i++) {
+        if (tilePalettes[i] != paletteNum)
+            continue;
+
+        for (int j = 0; j < tiles[i].numColors; j++) {
+            unsigned short color = tiles[i].colors[j].color;
+
+            if (counts[color] == 0)
+                entries[numEntries++].color = color;
+            counts[color] += tiles[i].colors[j].count;
+        }
+    }
+
+    for (int i = 0; i < numEntries; i++) {
+        entries[i].count = counts[entries[i].color];
+        counts[entries[i].color] = 0;
+    }
+
+    palette->numColors = MedianCut(entries, numEntries, colorsPerPalette, palette->colors);
+    memset(palette->nearest, 0xFF, NUM_GBA_COLORS * sizeof(short));
+}
+
+// Reduces an RGBA image to numPalettes palettes of colorsPerPalette colors,
+// with index 0 of each palette kept free for transparent pixels. Tiles are
+// clustered by which palette reproduces them with the least squared error,
+// alternating between rebuilding each palette from its tiles with median cut
+// and moving tiles to their best palette until nothing changes.
+void QuantizeImage(unsigned char *rgba, int width, int height, int colorsPerPalette, int numPalettes, unsigned char *indices, unsigned char *tilePalettes, struct Palette *palette)
+{
+    int tilesWide = width / 8;
+    int numTiles = tilesWide * (height / 8);
+    unsigned short *colors = malloc(width * height * sizeof(unsigned short));
+    struct TileColors *tiles = malloc(numTiles * sizeof(struct TileColors));
+    struct ColorCount *tileEntries = malloc(numTiles * 64 * sizeof(struct ColorCount));
+    struct ColorCount *entries = malloc(NUM_GBA_COLORS * sizeof(struct ColorCount));
+    struct QuantPalette *palettes = malloc(numPalettes * sizeof(struct QuantPalette));
+    int *counts = calloc(NUM_GBA_COLORS, sizeof(int));
+
+    if (colors == NULL || tiles == NULL || tileEntries == NULL || entries == NULL || palettes == NULL || counts == NULL)
+        FATAL_ERROR("Failed to allocate memory for quantization.\n");
+
+    for (int i = 0; i < width * height; i++) {
+        unsigned char *pixel = &rgba[i * 4];
+
+        if (pixel[3] < 0x80)
+            colors[i] = TRANSPARENT_COLOR;
+        else
+            colors[i] = ((pixel[2] >> 3) << 10) | ((pixel[1] >> 3) << 5) | (pixel[0] >> 3);
+    }
+
+    for (int t = 0; t < numTiles; t++) {
+        int x = (t % tilesWide) * 8;
+        int y = (t / tilesWide) * 8;
+
+        tiles[t].colors = &tileEntries[t * 64];
+        tiles[t].numColors = 0;
+
+        for (int j = 0; j < 64; j++) {
+            unsigned short color = colors[(y + j / 8) * width + x + j % 8];
+
+            if (color == TRANSPARENT_COLOR)
+                continue;
+            if (counts[color]++ == 0)
+                tiles[t].colors[tiles[t].numColors++].color = color;
+        }
+
+        for (int j = 0; j < tiles[t].numColors; j++) {
+            tiles[t].colors[j].count = counts[tiles[t].colors[j].color];
+            counts[tiles[t].colors[j].color] = 0;
+        }
+    }
+
+    for (int p = 0; p < numPalettes; p++) {
+        palettes[p].nearest = malloc(NUM_GBA_COLORS * sizeof(short));
+        if (palettes[p].nearest == NULL)
+            FATAL_ERROR("Failed to allocate memory for quantization.\n");
+    }
+
+    // Seed the clusters by median cutting the tiles' average colors.
+    memset(tilePalettes, 0, numTiles);
+
+    if (numPalettes > 1) {
+        int numEntries = 0;
+        unsigned short *meanColors = malloc(numTiles * sizeof(unsigned short));
+
+        if (meanColors == NULL)
+            FATAL_ERROR("Failed to allocate memory for quantization.\n");
+
+        for (int t = 0; t < numTiles; t++) {
+            long total = 0;
+            long sums[3] = { 0, 0, 0 };
+
+            for (int j = 0; j < tiles[t].numColors; j++) {
+                total += tiles[t].colors[j].count;
+                for (int axis = 0; axis < 3; axis++)
+                    sums[axis] += (long)COLOR_COMPONENT(tiles[t].colors[j].color, axis) * tiles[t].colors[j].count;
+            }
+
+            if (total == 0)
+                continue;
+
+            meanColors[t] = 0;
+            for (int axis = 0; axis < 3; axis++)
+                meanColors[t] |= (sums[axis] / total) << (axis * 5);
+            entries[numEntries].color = meanColors[t];
+            entries[numEntries].count = total;
+            numEntries++;
+        }
+
+        struct QuantPalette *seeds = &palettes[0];
+        seeds->numColors = MedianCut(entries, numEntries, numPalettes, seeds->colors);
+        memset(seeds->nearest, 0xFF, NUM_GBA_COLORS * sizeof(short));
+
+        for (int t = 0; t < numTiles; t++) {
+            if (tiles[t].numColors > 0)
+                tilePalettes[t] = NearestColor(seeds, meanColors[t]);
+        }
+
+        free(meanColors);
+    }
+
+    for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
+        for (int p = 0; p < numPalettes; p++)
+            BuildPalette(&palettes[p], tiles, tilePalettes, numTiles, p, colorsPerPalette, counts, entries);
+
+        // Give any palette that ended up unused the worst reproduced tile.
+        for (int p = 0; p < numPalettes; p++) {
+            if (palettes[p].numColors != 0)
+                continue;
+
+            int worstTile = -1;
+            long worstError = 0;
+
+            for (int t = 0; t < numTiles; t++) {
+                long error = TileError(&tiles[t], &palettes[tilePalettes[t]]);
+                if (error > worstError) {
+                    worstError = error;
+                    worstTile = t;
+                }
+            }
+
+            if (worstTile == -1)
+                break;
+
+            int oldPalette = tilePalettes[worstTile];
+            tilePalettes[worstTile] = p;
+            BuildPalette(&palettes[p], tiles, tilePalettes, numTiles, p, colorsPerPalette, counts, entries);
+            BuildPalette(&palettes[oldPalette], tiles, tilePalettes, numTiles, oldPalette, colorsPerPalette, counts, entries);
+        }
+
+        bool changed = false;
+
+        for (int t = 0; t < numTiles; t++) {
+            int best = tilePalettes[t];
+            long bestError = TileError(&tiles[t], &palettes[best]);
+
+            for (int p = 0; p < numPalettes && bestError > 0; p++) {
+                long error = TileError(&tiles[t], &palettes[p]);
+                if (error < bestError) {
+                    bestError = error;
+                    best = p;
+                }
+            }
+
+            if (best != tilePalettes[t]) {
+                tilePalettes[t] = best;
+                changed = true;
+            }
+        }
+
+        if (!changed)
+            break;
+    }
+
+    for (int i = 0; i < width * height; i++) {
+        int t = ((i / width) / 8) * tilesWide + (i % width) / 8;
+
+        if (colors[i] == TRANSPARENT_COLOR)
+            indices[i] = 0;
+        else
+            indices[i] = 1 + NearestColor(&palettes[tilePalettes[t]], colors[i]);
+    }
+
+    palette->numColors = numPalettes * (colorsPerPalette + 1);
+    memset(palette->colors, 0, sizeof(palette->colors));
+
+    for (int p = 0; p < numPalettes; p++) {
+        for (int i = 0; i < palettes[p].numColors; i++) {
+            struct Color *color = &palette->colors[p * (colorsPerPalette + 1) + 1 + i];
+            unsigned short gbaColor = palettes[p].colors[i];
+
+            // Expand 5-bit components so that WriteGbaPalette gives them back unchanged.
+            color->red = (COLOR_COMPONENT(gbaColor, 0) << 3) | (COLOR_COMPONENT(gbaColor, 0) >> 2);
+            color->green = (COLOR_COMPONENT(gbaColor, 1) << 3) | (COLOR_COMPONENT(gbaColor, 1) >> 2);
+            color->blue = (COLOR_COMPONENT(gbaColor, 2) << 3) | (COLOR_COMPONENT(gbaColor, 2) >> 2);
+        }
+
+        free(palettes[p].nearest);
+    }
+
+    free(colors);
+    free(tiles);
+    free(tileEntries);
+    free(entries);
+    free(palettes);
+    free(counts);
+}
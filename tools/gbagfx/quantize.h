@@ -0,0 +1,8 @@
+#ifndef QUANTIZE_H
+#define QUANTIZE_H
+
+#include "gfx.h"
+
+void QuantizeImage(unsigned char *rgba, int width, int height, int colorsPerPalette, int numPalettes, unsigned char *indices, unsigned char *tilePalettes, struct Palette *palette);
+
+#endif // QUANTIZE_H
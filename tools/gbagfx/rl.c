@@ -2,6 +2,8 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 #include "global.h"
 #include "rl.h"
 
@@ -31,23 +33,23 @@ unsigned char *RLDecompress(unsigned char *src, int srcSize, int *uncompressedSi
         if (compressed)
         {
             int length = (flags & 0x7F) + 3;
-            unsigned char data = src[srcPos++];
 
-            if (destPos + length > destSize)
+            if (srcPos >= srcSize || destPos + length > destSize)
                 goto fail;
 
-            for (int i = 0; i < length; i++)
-                dest[destPos++] = data;
+            memset(&dest[destPos], src[srcPos++], length);
+            destPos += length;
         }
         else
         {
             int length = (flags & 0x7F) + 1;
 
-            if (destPos + length > destSize)
+            if (srcPos + length > srcSize || destPos + length > destSize)
                 goto fail;
 
-            for (int i = 0; i < length; i++)
-                dest[destPos++] = src[srcPos++];
+            memcpy(&dest[destPos], &src[srcPos], length);
+            srcPos += length;
+            destPos += length;
         }
 
         if (destPos == destSize)
@@ -61,12 +63,68 @@ fail:
     FATAL_ERROR("Fatal error while decompressing RL file.\n");
 }
 
+// Nonzero if any byte of x is zero.
+#define HAS_ZERO_BYTE(x) (((x) - 0x0101010101010101ULL) & ~(x) & 0x8080808080808080ULL)
+
+static uint64_t LoadWord(const unsigned char *src)
+{
+    uint64_t word;
+
+    memcpy(&word, src, sizeof(word));
+    return word;
+}
+
+// Returns the first position in [start, end) where three equal bytes begin,
+// or end if there is none. The caller guarantees that end + 2 <= srcSize.
+static int FindRun(const unsigned char *src, int start, int end)
+{
+    int pos = start;
+
+    // Compare each byte with the next two, eight positions at a time, and
+    // only fall back to single bytes once a word contains a candidate.
+    while (pos + 8 <= end)
+    {
+        uint64_t word = LoadWord(&src[pos]);
+        uint64_t mismatches = (word ^ LoadWord(&src[pos + 1])) | (word ^ LoadWord(&src[pos + 2]));
+
+        if (HAS_ZERO_BYTE(mismatches))
+            break;
+
+        pos += 8;
+    }
+
+    for (; pos < end; pos++)
+    {
+        if (src[pos] == src[pos + 1] && src[pos] == src[pos + 2])
+            return pos;
+    }
+
+    return end;
+}
+
+// Returns how many bytes starting at start equal src[start], up to maxLength.
+static int RunLength(const unsigned char *src, int start, int maxLength)
+{
+    uint64_t pattern = 0x0101010101010101ULL * src[start];
+    int length = 0;
+
+    while (length + 8 <= maxLength && LoadWord(&src[start + length]) == pattern)
+        length += 8;
+
+    while (length < maxLength && src[start + length] == src[start])
+        length++;
+
+    return length;
+}
+
 unsigned char *RLCompress(unsigned char *src, int srcSize, int *compressedSize)
 {
     if (srcSize <= 0)
         goto fail;
 
-    int worstCaseDestSize = 4 + srcSize * 2;
+    // The output is largest when nothing repeats, which costs one flag byte
+    // for every 128 literal bytes.
+    int worstCaseDestSize = 4 + srcSize + (srcSize + 0x7F) / 0x80;
 
     // Round up to the next multiple of four.
     worstCaseDestSize = (worstCaseDestSize + 3) & ~3;
@@ -85,64 +143,44 @@ unsigned char *RLCompress(unsigned char *src, int srcSize, int *compressedSize)
     int srcPos = 0;
     int destPos = 4;
 
-    for (;;)
+    while (srcPos < srcSize)
     {
-        bool compress = false;
-        int uncompressedStart = srcPos;
-        int uncompressedLength = 0;
-
-        while (srcPos < srcSize && uncompressedLength < (0x7F + 1))
-        {
-            compress = (srcPos + 2 < srcSize && src[srcPos] == src[srcPos + 1] && src[srcPos] == src[srcPos + 2]);
+        int maxLiteralLength = srcSize - srcPos < 0x7F + 1 ? srcSize - srcPos : 0x7F + 1;
+        int searchEnd = srcPos + maxLiteralLength < srcSize - 2 ? srcPos + maxLiteralLength : srcSize - 2;
 
-            if (compress)
-                break;
+        if (searchEnd < srcPos)
+            searchEnd = srcPos;
 
-            srcPos++;
-            uncompressedLength++;
-        }
+        int runStart = FindRun(src, srcPos, searchEnd);
+        bool compress = runStart < searchEnd;
+        int uncompressedLength = compress ? runStart - srcPos : maxLiteralLength;
 
         if (uncompressedLength > 0)
         {
             dest[destPos++] = uncompressedLength - 1;
-
-            for (int i = 0; i < uncompressedLength; i++)
-                dest[destPos++] = src[uncompressedStart + i];
+            memcpy(&dest[destPos], &src[srcPos], uncompressedLength);
+            destPos += uncompressedLength;
+            srcPos += uncompressedLength;
         }
 
         if (compress)
         {
-            unsigned char data = src[srcPos];
-            int compressedLength = 0;
-
-            while (compressedLength < (0x7F + 3)
-                && srcPos + compressedLength < srcSize
-                && src[srcPos + compressedLength] == data)
-            {
-                compressedLength++;
-            }
+            int maxRunLength = srcSize - srcPos < 0x7F + 3 ? srcSize - srcPos : 0x7F + 3;
+            int compressedLength = RunLength(src, srcPos, maxRunLength);
 
             dest[destPos++] = 0x80 | (compressedLength - 3);
-            dest[destPos++] = data;
+            dest[destPos++] = src[srcPos];
 
             srcPos += compressedLength;
         }
+    }
 
-        if (srcPos == srcSize)
-        {
-            // Pad to multiple of 4 bytes.
-            int remainder = destPos % 4;
-
-            if (remainder != 0)
-            {
-                for (int i = 0; i < 4 - remainder; i++)
-                    dest[destPos++] = 0;
-            }
+    // Pad to multiple of 4 bytes.
+    while (destPos % 4 != 0)
+        dest[destPos++] = 0;
 
-            *compressedSize = destPos;
-            return dest;
-        }
-    }
+    *compressedSize = destPos;
+    return dest;
 
 fail:
     FATAL_ERROR("Fatal error while compressing RL file.\n");
@@ -129,3 +129,23 @@ void WriteWholeFile(char *path, void *buffer, int bufferSize)
 
 	fclose(fp);
 }
+
+void AppendToBuffer(struct Buffer *buffer, const void *data, int size)
+{
+	if (buffer->size + size > buffer->capacity) {
+		int capacity = buffer->capacity > 0 ? buffer->capacity : 256;
+
+		while (capacity < buffer->size + size)
+			capacity *= 2;
+
+		buffer->data = realloc(buffer->data, capacity);
+
+		if (buffer->data == NULL)
+			FATAL_ERROR("Failed to allocate memory for output buffer.\n");
+
+		buffer->capacity = capacity;
+	}
+
+	memcpy(&buffer->data[buffer->size], data, size);
+	buffer->size += size;
+}
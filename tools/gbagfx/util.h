@@ -5,11 +5,18 @@
 
 #include <stdbool.h>
 
+struct Buffer {
+	unsigned char *data;
+	int size;
+	int capacity;
+};
+
 bool ParseNumber(char *s, char **end, int radix, int *intValue);
 char *GetFileExtension(char *path);
 char *GetFileExtensionAfterDot(char *path);
 unsigned char *ReadWholeFile(char *path, int *size);
 unsigned char *ReadWholeFileZeroPadded(char *path, int *size, int padAmount);
 void WriteWholeFile(char *path, void *buffer, int bufferSize);
+void AppendToBuffer(struct Buffer *buffer, const void *data, int size);
 
 #endif // UTIL_H
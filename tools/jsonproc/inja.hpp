@@ -49,6 +49,26 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+
+// ---
+
+
+// LOCAL CHANGES: this copy of inja is patched for jsonproc. A loop no longer
+// copies the whole data into each level just to add its variables. Instead
+// the Renderer resolves names through the loop levels before the data:
+//
+//   Renderer::find_loop_var    finds a loop variable, innermost level first
+//   Renderer::lookup           resolves a json pointer through the loop vars
+//   Renderer::current_data     rebuilds the data as seen inside the loops,
+//                              for included templates
+//   LoopLevel::find_var        the variables one level defines
+//   LoopLevel::add_vars        adds those variables to a copy of the data
+//
+// LoopLevel::data is replaced by the key, loop_data and has_loop_data
+// members. The StartLoop/EndLoop ops, update_loop_data and Include are adjusted
+// to match. Output is unchanged. The full change is in inja-local.patch, which
+// must be reapplied if this file is ever replaced with a newer upstream copy.
+
 #ifndef PANTOR_INJA_HPP
 #define PANTOR_INJA_HPP
 
@@ -2834,7 +2854,7 @@ class Renderer {
         break;
     }
     try {
-      return &m_data->at(json::json_pointer(ptr.data()));
+      return &lookup(ptr);
     } catch (std::exception&) {
       // try to evaluate as a no-argument callback
       if (auto callback = m_callbacks.find_callback(bc.str, 0)) {
@@ -2864,19 +2884,52 @@ class Renderer {
     }
   }
 
+  // Loop variables are looked up in the loop levels, innermost first, before
+  // falling back to the data. They shadow anything of the same name further
+  // out, just as if each level held a copy of the data with them added.
+  const json* find_loop_var(nonstd::string_view name) const {
+    for (auto level = m_loop_stack.rbegin(); level != m_loop_stack.rend(); ++level) {
+      if (const json* var = level->find_var(name)) {
+        return var;
+      }
+    }
+    return nullptr;
+  }
+
+  const json& lookup(nonstd::string_view ptr) const {
+    if (ptr.size() > 1 && !m_loop_stack.empty()) {
+      size_t slash = ptr.find('/', 1);
+      nonstd::string_view name = ptr.substr(1, slash == nonstd::string_view::npos ? nonstd::string_view::npos : slash - 1);
+
+      if (const json* var = find_loop_var(name)) {
+        if (slash == nonstd::string_view::npos) {
+          return *var;
+        }
+        return var->at(json::json_pointer(static_cast<std::string>(ptr.substr(slash))));
+      }
+    }
+    return m_data->at(json::json_pointer(static_cast<std::string>(ptr)));
+  }
+
+  // The data as seen from inside the current loops, for included templates.
+  json current_data() const {
+    json result = *m_data;
+    for (const auto& level : m_loop_stack) {
+      level.add_vars(result);
+    }
+    return result;
+  }
+
   void update_loop_data()  {
     LoopLevel& level = m_loop_stack.back();
 
     if (level.loop_type == LoopLevel::Type::Array) {
-      level.data[static_cast<std::string>(level.value_name)] = level.values.at(level.index);  // *level.it;
-      auto& loopData = level.data["loop"];
-      loopData["index"] = level.index;
-      loopData["index1"] = level.index + 1;
-      loopData["is_first"] = (level.index == 0);
-      loopData["is_last"] = (level.index == level.size - 1);
+      level.loop_data["index"] = level.index;
+      level.loop_data["index1"] = level.index + 1;
+      level.loop_data["is_first"] = (level.index == 0);
+      level.loop_data["is_last"] = (level.index == level.size - 1);
     } else {
-      level.data[static_cast<std::string>(level.key_name)] = level.map_it->first;
-      level.data[static_cast<std::string>(level.value_name)] = *level.map_it->second;
+      level.key = static_cast<std::string>(level.map_it->first);
     }
   }
 
@@ -2892,7 +2945,9 @@ class Renderer {
     Type loop_type;
     nonstd::string_view key_name;   // variable name for keys
     nonstd::string_view value_name; // variable name for values
-    json data;                      // data with loop info added
+    json key;                       // current key, for maps
+    json loop_data;                 // "loop" variable
+    bool has_loop_data;
 
     json values;                    // values to iterate over
 
@@ -2906,6 +2961,34 @@ class Renderer {
     MapValues map_values;           // values to iterate over
     MapValues::iterator map_it;     // iterator over values
 
+    const json* value() const {
+      return loop_type == Type::Array ? &values[index] : map_it->second;
+    }
+
+    // The variables this level defines, in the order the last assigned
+    // wins when names collide.
+    const json* find_var(nonstd::string_view name) const {
+      if (loop_type == Type::Array) {
+        if (has_loop_data && name == "loop") return &loop_data;
+        if (name == value_name) return value();
+      } else {
+        if (name == value_name) return value();
+        if (name == key_name) return &key;
+        if (has_loop_data && name == "loop") return &loop_data;
+      }
+      return nullptr;
+    }
+
+    void add_vars(json& data) const {
+      if (loop_type == Type::Array) {
+        data[static_cast<std::string>(value_name)] = *value();
+        if (has_loop_data) data["loop"] = loop_data;
+      } else {
+        if (has_loop_data) data["loop"] = loop_data;
+        data[static_cast<std::string>(key_name)] = key;
+        data[static_cast<std::string>(value_name)] = *value();
+      }
+    }
   };
 
   std::vector<LoopLevel> m_loop_stack;
@@ -3209,7 +3292,7 @@ class Renderer {
           break;
         }
         case Bytecode::Op::Include:
-          Renderer(m_included_templates, m_callbacks).render_to(os, m_included_templates.find(get_imm(bc)->get_ref<const std::string&>())->second, *m_data);
+          Renderer(m_included_templates, m_callbacks).render_to(os, m_included_templates.find(get_imm(bc)->get_ref<const std::string&>())->second, m_loop_stack.empty() ? *m_data : current_data());
           break;
         case Bytecode::Op::Callback: {
           auto callback = m_callbacks.find_callback(bc.str, bc.args);
@@ -3240,11 +3323,20 @@ class Renderer {
             break;
           }
 
+          const json* parent_loop_ptr = find_loop_var("loop");
+          json parent_loop = parent_loop_ptr ? *parent_loop_ptr : json();
+          if (!parent_loop_ptr && m_data->is_object()) {
+            auto parent_loop_it = m_data->find("loop");
+            if (parent_loop_it != m_data->end()) {
+              parent_loop_ptr = &*parent_loop_it;
+              parent_loop = *parent_loop_it;
+            }
+          }
+
           m_loop_stack.emplace_back();
           LoopLevel& level = m_loop_stack.back();
           level.value_name = bc.str;
           level.values = std::move(m_stack.back());
-          level.data = (*m_data);
           m_stack.pop_back();
 
           if (bc.value.is_string()) {
@@ -3275,14 +3367,13 @@ class Renderer {
           }
 
           // provide parent access in nested loop
-          auto parent_loop_it = level.data.find("loop");
-          if (parent_loop_it != level.data.end()) {
-            json loop_copy = *parent_loop_it;
-            (*parent_loop_it)["parent"] = std::move(loop_copy);
+          if (parent_loop_ptr) {
+            json loop_copy = parent_loop;
+            level.loop_data = std::move(parent_loop);
+            level.loop_data["parent"] = std::move(loop_copy);
           }
+          level.has_loop_data = parent_loop_ptr || level.loop_type == LoopLevel::Type::Array;
 
-          // set "current" data to loop data
-          m_data = &level.data;
           update_loop_data();
           break;
         }
@@ -3303,12 +3394,6 @@ class Renderer {
 
           if (done) {
             m_loop_stack.pop_back();
-            // set "current" data to outer loop data or main data as appropriate
-            if (!m_loop_stack.empty()) {
-              m_data = &m_loop_stack.back().data;
-            } else {
-              m_data = &data;
-            }
             break;
           }
 
@@ -2,41 +2,52 @@
 
 #include "jsonproc.h"
 
+#include <cstdio>
+
 #include <map>
 
+#include <stdexcept>
+
 #include <string>
 using std::string; using std::to_string;
 
+#include <fstream>
+using std::ifstream; using std::ofstream;
+
+#include <sstream>
+
+#include <vector>
+using std::vector;
+
 #include <inja.hpp>
 using namespace inja;
 using json = nlohmann::json;
 
 std::map<string, string> customVars;
 
-void set_custom_var(string key, string value)
+void set_custom_var(const string &key, const string &value)
 {
     customVars[key] = value;
 }
 
-string get_custom_var(string key)
+string get_custom_var(const string &key)
 {
     return customVars[key];
 }
 
-int main(int argc, char *argv[])
-{
-    if (argc != 4)
-        FATAL_ERROR("USAGE: jsonproc <json-filepath> <template-filepath> <output-filepath>\n");
-
-    string jsonfilepath = argv[1];
-    string templateFilepath = argv[2];
-    string outputFilepath = argv[3];
+// The files of the output being rendered, for doNotModifyHeader.
+string currentJsonFilepath;
+string currentTemplateFilepath;
 
-    Environment env;
+// Templates and JSON documents by path, so that each is only parsed once
+// however many outputs use it.
+std::map<string, Template> templates;
+std::map<string, json> jsonDocuments;
 
-    // Add custom command callbacks.
-    env.add_callback("doNotModifyHeader", 0, [jsonfilepath, templateFilepath](Arguments& args) {
-        return "//\n// DO NOT MODIFY THIS FILE! It is auto-generated from " + jsonfilepath +" and Inja template " + templateFilepath + "\n//\n";
+void add_callbacks(Environment &env)
+{
+    env.add_callback("doNotModifyHeader", 0, [](Arguments& args) {
+        return "//\n// DO NOT MODIFY THIS FILE! It is auto-generated from " + currentJsonFilepath +" and Inja template " + currentTemplateFilepath + "\n//\n";
     });
 
     env.add_callback("subtract", 2, [](Arguments& args) {
@@ -46,44 +57,46 @@ int main(int argc, char *argv[])
         return minuend - subtrahend;
     });
 
+    // The string arguments below are only read, so they're taken by
+    // reference rather than copied out of the json.
     env.add_callback("setVar", 2, [=](Arguments& args) {
-        string key = args.at(0)->get<string>();
-        string value = args.at(1)->get<string>();
+        const string &key = args.at(0)->get_ref<const string&>();
+        const string &value = args.at(1)->get_ref<const string&>();
         set_custom_var(key, value);
         return "";
     });
 
     env.add_callback("setVarInt", 2, [=](Arguments& args) {
-        string key = args.at(0)->get<string>();
-        string value = to_string(args.at(1)->get<int>());
-        set_custom_var(key, value);
+        const string &key = args.at(0)->get_ref<const string&>();
+        set_custom_var(key, to_string(args.at(1)->get<int>()));
         return "";
     });
 
     env.add_callback("getVar", 1, [=](Arguments& args) {
-        string key = args.at(0)->get<string>();
+        const string &key = args.at(0)->get_ref<const string&>();
         return get_custom_var(key);
     });
 
     env.add_callback("concat", 2, [](Arguments& args) {
-        string first = args.at(0)->get<string>();
-        string second = args.at(1)->get<string>();
-        return first + second;
+        const string &first = args.at(0)->get_ref<const string&>();
+        const string &second = args.at(1)->get_ref<const string&>();
+        string result;
+        result.reserve(first.size() + second.size());
+        return result.append(first).append(second);
     });
 
     env.add_callback("removePrefix", 2, [](Arguments& args) {
-        string rawValue = args.at(0)->get<string>();
-        string prefix = args.at(1)->get<string>();
-        string::size_type i = rawValue.find(prefix);
-        if (i != 0)
+        const string &rawValue = args.at(0)->get_ref<const string&>();
+        const string &prefix = args.at(1)->get_ref<const string&>();
+        if (rawValue.compare(0, prefix.length(), prefix) != 0)
             return rawValue;
 
-        return rawValue.erase(0, prefix.length());
+        return rawValue.substr(prefix.length());
     });
 
     env.add_callback("removeSuffix", 2, [](Arguments& args) {
-        string rawValue = args.at(0)->get<string>();
-        string suffix = args.at(1)->get<string>();
+        const string &rawValue = args.at(0)->get_ref<const string&>();
+        const string &suffix = args.at(1)->get_ref<const string&>();
         string::size_type i = rawValue.rfind(suffix);
         if (i == string::npos)
             return rawValue;
@@ -95,15 +108,142 @@ int main(int argc, char *argv[])
     env.add_callback("isEmpty", 1, [](Arguments& args) {
         return args.at(0)->empty();
     });
+}
+
+const Template &get_template(Environment &env, const string &templateFilepath)
+{
+    auto tmpl = templates.find(templateFilepath);
+    if (tmpl == templates.end())
+        tmpl = templates.emplace(templateFilepath, env.parse_template(templateFilepath)).first;
+
+    return tmpl->second;
+}
+
+const json &get_json(Environment &env, const string &jsonFilepath)
+{
+    auto data = jsonDocuments.find(jsonFilepath);
+    if (data == jsonDocuments.end())
+        data = jsonDocuments.emplace(jsonFilepath, env.load_json(jsonFilepath)).first;
+
+    return data->second;
+}
+
+// Renders one output. Each starts with no custom vars set, just as it would
+// in a run of its own.
+void process(Environment &env, const string &jsonFilepath, const string &templateFilepath, const string &outputFilepath)
+{
+    const Template &tmpl = get_template(env, templateFilepath);
+    const json &data = get_json(env, jsonFilepath);
+
+    currentJsonFilepath = jsonFilepath;
+    currentTemplateFilepath = templateFilepath;
+
+    write_output(env, tmpl, data, outputFilepath);
+}
+
+// Writes contents to a file unless it already holds exactly that, so that
+// nothing built from an unchanged file is rebuilt. Returns whether it wrote.
+bool write_if_changed(const string &filepath, const string &contents)
+{
+    ifstream existing(filepath, ifstream::binary);
+
+    if (existing.is_open())
+    {
+        std::ostringstream existingContents;
+        existingContents << existing.rdbuf();
+        if (existingContents.str() == contents)
+            return false;
+        existing.close();
+    }
+
+    ofstream file(filepath, ofstream::binary);
+    if (!file.is_open())
+        throw std::runtime_error("cannot open " + filepath + " for writing");
+
+    file << contents;
+    file.close();
+
+    if (file.fail())
+        throw std::runtime_error("failed to write " + filepath);
+
+    return true;
+}
+
+// Like process, but leaves the output alone when it already holds what would
+// be rendered, so that nothing built from it is rebuilt.
+void process_if_changed(Environment &env, const string &jsonFilepath, const string &templateFilepath, const string &outputFilepath)
+{
+    const Template &tmpl = get_template(env, templateFilepath);
+    const json &data = get_json(env, jsonFilepath);
+
+    currentJsonFilepath = jsonFilepath;
+    currentTemplateFilepath = templateFilepath;
+    customVars.clear();
+
+    write_if_changed(outputFilepath, env.render(tmpl, data));
+}
+
+// Renders straight into the file rather than building the whole output as a
+// string first. The write buffer is shared by every output.
+void write_output(Environment &env, const Template &tmpl, const json &data, const string &outputFilepath)
+{
+    customVars.clear();
+
+    static vector<char> writeBuffer(1 << 18);
+    ofstream file;
+    file.rdbuf()->pubsetbuf(writeBuffer.data(), writeBuffer.size());
+    file.open(outputFilepath);
+
+    if (!file.is_open())
+        throw std::runtime_error("cannot open " + outputFilepath + " for writing");
 
     try
     {
-        env.write_with_json_file(templateFilepath, jsonfilepath, outputFilepath);
+        env.render_to(file, tmpl, data);
+        file.close();
     }
-    catch (const std::exception& e)
+    catch (...)
     {
-        FATAL_ERROR("JSONPROC_ERROR: %s\n", e.what());
+        // Don't leave a partly written output behind to look up to date.
+        file.close();
+        std::remove(outputFilepath.c_str());
+        throw;
+    }
+
+    if (file.fail())
+        throw std::runtime_error("failed to write " + outputFilepath);
+}
+
+// Reads a manifest of "json-filepath template-filepath output-filepath"
+// lines. Blank lines and anything after a '#' are skipped.
+vector<ManifestEntry> read_manifest(const string &manifestFilepath)
+{
+    ifstream file(manifestFilepath);
+
+    if (!file.is_open())
+        FATAL_ERROR("Cannot open manifest %s for reading.\n", manifestFilepath.c_str());
+
+    vector<ManifestEntry> entries;
+    string line;
+    int lineNum = 0;
+
+    while (std::getline(file, line))
+    {
+        lineNum++;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream fields(line);
+        ManifestEntry entry;
+        entry.lineNum = lineNum;
+        string extra;
+
+        if (!(fields >> entry.jsonFilepath))
+            continue;
+        if (!(fields >> entry.templateFilepath >> entry.outputFilepath) || (fields >> extra))
+            FATAL_ERROR("%s:%d: expected \"<json-filepath> <template-filepath> <output-filepath>\"\n", manifestFilepath.c_str(), lineNum);
+
+        entries.push_back(entry);
     }
 
-    return 0;
+    return entries;
 }
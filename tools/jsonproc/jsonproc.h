@@ -29,4 +29,28 @@ do                                          \
 
 #endif // _MSC_VER
 
+#include <string>
+
+#include <vector>
+
+#include <inja.hpp>
+
+void add_callbacks(inja::Environment &env);
+
+void process(inja::Environment &env, const std::string &jsonFilepath, const std::string &templateFilepath, const std::string &outputFilepath);
+
+void process_if_changed(inja::Environment &env, const std::string &jsonFilepath, const std::string &templateFilepath, const std::string &outputFilepath);
+
+void write_output(inja::Environment &env, const inja::Template &tmpl, const nlohmann::json &data, const std::string &outputFilepath);
+
+struct ManifestEntry
+{
+    int lineNum;
+    std::string jsonFilepath;
+    std::string templateFilepath;
+    std::string outputFilepath;
+};
+
+std::vector<ManifestEntry> read_manifest(const std::string &manifestFilepath);
+
 #endif // JSONPROC_H
@@ -0,0 +1,135 @@
+// Benchmarks rendering a template with a JSON file, optionally scaled up so
+// that the cost of large outputs shows. Scaling repeats the members of each
+// array found in the elements of the root's arrays, which for
+// wild_encounters.json means each group's encounters.
+
+#include "jsonproc.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+using json = nlohmann::json;
+
+static void scale_arrays(json &array, int scale)
+{
+    json scaled = json::array();
+
+    for (int i = 0; i < scale; i++)
+        for (const json &member : array)
+            scaled.push_back(member);
+
+    array = std::move(scaled);
+}
+
+static void scale(json &data, int scale)
+{
+    for (json &root_member : data)
+    {
+        if (!root_member.is_array())
+            continue;
+
+        for (json &element : root_member)
+        {
+            if (!element.is_object())
+                continue;
+
+            for (json &member : element)
+                if (member.is_array())
+                    scale_arrays(member, scale);
+        }
+    }
+}
+
+static size_t file_size(const string &filepath)
+{
+    std::ifstream file(filepath, std::ifstream::binary | std::ifstream::ate);
+    return file.is_open() ? (size_t)file.tellg() : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int iterations = 10;
+    int scale_factor = 1;
+    vector<string> filepaths;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-n") == 0 || std::strcmp(argv[i], "-x") == 0)
+        {
+            int &value = argv[i][1] == 'n' ? iterations : scale_factor;
+            if (i + 1 >= argc || (value = std::atoi(argv[i + 1])) < 1)
+                FATAL_ERROR("Expected a positive number following \"%s\".\n", argv[i]);
+            i++;
+        }
+        else
+        {
+            filepaths.push_back(argv[i]);
+        }
+    }
+
+    if (filepaths.size() != 3)
+        FATAL_ERROR("USAGE: jsonproc_bench [-n <iterations>] [-x <scale>] <json-filepath> <template-filepath> <output-filepath>\n");
+
+    inja::Environment env;
+    add_callbacks(env);
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::duration load_time = Clock::duration::zero();
+    Clock::duration string_time = Clock::duration::zero();
+    Clock::duration stream_time = Clock::duration::zero();
+
+    try
+    {
+        inja::Template tmpl = env.parse_template(filepaths[1]);
+        json data;
+
+        for (int iteration = 0; iteration < iterations; iteration++)
+        {
+            Clock::time_point start = Clock::now();
+            data = env.load_json(filepaths[0]);
+            load_time += Clock::now() - start;
+        }
+
+        scale(data, scale_factor);
+
+        for (int iteration = 0; iteration < iterations; iteration++)
+        {
+            // How outputs used to be written, for comparison.
+            Clock::time_point start = Clock::now();
+            std::ofstream file(filepaths[2]);
+            file << env.render(tmpl, data);
+            file.close();
+            Clock::time_point rendered = Clock::now();
+
+            write_output(env, tmpl, data, filepaths[2]);
+            Clock::time_point streamed = Clock::now();
+
+            string_time += rendered - start;
+            stream_time += streamed - rendered;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        FATAL_ERROR("JSONPROC_ERROR: %s\n", e.what());
+    }
+
+    double load_ms = std::chrono::duration<double, std::milli>(load_time).count() / iterations;
+    double string_ms = std::chrono::duration<double, std::milli>(string_time).count() / iterations;
+    double stream_ms = std::chrono::duration<double, std::milli>(stream_time).count() / iterations;
+
+    std::printf("%.1f KiB of JSON scaled %dx, %.1f KiB of output, %d iterations\n",
+                file_size(filepaths[0]) / 1024.0, scale_factor, file_size(filepaths[2]) / 1024.0, iterations);
+    std::printf("load:             %8.3f ms/iteration\n", load_ms);
+    std::printf("render to string: %8.3f ms/iteration\n", string_ms);
+    std::printf("render to file:   %8.3f ms/iteration\n", stream_ms);
+
+    return 0;
+}
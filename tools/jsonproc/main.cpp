@@ -0,0 +1,50 @@
+// main.cpp
+
+#include "jsonproc.h"
+
+#include <string>
+using std::string;
+
+using namespace inja;
+
+int main(int argc, char *argv[])
+{
+    bool isManifest = argc == 3 && string(argv[1]) == "--manifest";
+
+    if (argc != 4 && !isManifest)
+        FATAL_ERROR("USAGE: jsonproc <json-filepath> <template-filepath> <output-filepath>\n"
+                    "       jsonproc --manifest <manifest-filepath>\n");
+
+    Environment env;
+    add_callbacks(env);
+
+    if (!isManifest)
+    {
+        try
+        {
+            process_if_changed(env, argv[1], argv[2], argv[3]);
+        }
+        catch (const std::exception& e)
+        {
+            FATAL_ERROR("JSONPROC_ERROR: %s\n", e.what());
+        }
+
+        return 0;
+    }
+
+    string manifestFilepath = argv[2];
+
+    for (const ManifestEntry &entry : read_manifest(manifestFilepath))
+    {
+        try
+        {
+            process(env, entry.jsonFilepath, entry.templateFilepath, entry.outputFilepath);
+        }
+        catch (const std::exception& e)
+        {
+            FATAL_ERROR("JSONPROC_ERROR: %s:%d: %s\n", manifestFilepath.c_str(), entry.lineNum, e.what());
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,445 @@
+// json.cpp
+
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "json.h"
+
+using std::string;
+using std::vector;
+
+static const JsonValue null_value;
+
+const JsonValue &JsonValue::operator[](size_t i) const {
+    if (value_type != ARRAY || i >= count)
+        return null_value;
+
+    return items[i];
+}
+
+const JsonValue &JsonValue::operator[](const char *key) const {
+    const JsonValue *value = find(key, std::strlen(key));
+    return value ? *value : null_value;
+}
+
+const JsonValue &JsonValue::operator[](const string &key) const {
+    const JsonValue *value = find(key.data(), key.size());
+    return value ? *value : null_value;
+}
+
+const JsonValue &JsonValue::operator[](JsonString key) const {
+    const JsonValue *value = find(key.c_str(), key.size());
+    return value ? *value : null_value;
+}
+
+// Objects are small, so a linear scan beats building an index. It runs
+// backwards so that the last of any duplicate keys wins.
+const JsonValue *JsonValue::find(const char *key, size_t length) const {
+    if (value_type != OBJECT)
+        return nullptr;
+
+    for (size_t i = count; i-- > 0;) {
+        const JsonValue &member_key = items[2 * i];
+        if (member_key.count == length && std::memcmp(member_key.chars, key, length) == 0)
+            return &items[2 * i + 1];
+    }
+
+    return nullptr;
+}
+
+// A recursive descent parser that works in place on a NUL-terminated copy of
+// the text. Strings are unescaped where they lie, since unescaping never
+// lengthens them. The members of an array or object are gathered on a
+// scratch stack while it's being parsed, then moved to the arena together
+// once it's closed, so every container's members end up contiguous.
+class JsonParser {
+public:
+    JsonParser(char *text, size_t length, JsonValue *arena, vector<JsonValue> &stack, string &err)
+        : start(text), pos(text), end(text + length), arena(arena), stack(stack), err(err) {}
+
+    bool parse_document(JsonValue &root) {
+        if (!parse_value(root, 0))
+            return false;
+
+        skip_whitespace();
+        if (pos != end)
+            return fail("unexpected trailing " + describe(*pos));
+
+        return true;
+    }
+
+private:
+    static const int max_depth = 200;
+
+    char *start;
+    char *pos;
+    char *end;
+    JsonValue *arena;
+    vector<JsonValue> &stack;
+    string &err;
+
+    bool fail(const string &message) {
+        int line = 1;
+        for (const char *c = start; c < pos; c++)
+            line += *c == '\n';
+
+        err = "line " + std::to_string(line) + ": " + message;
+        return false;
+    }
+
+    string describe(char c) {
+        if (pos >= end)
+            return "end of input";
+        if (c >= 0x20 && c < 0x7F)
+            return string("'") + c + "'";
+        return "character " + std::to_string((unsigned char)c);
+    }
+
+    void skip_whitespace() {
+        while (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t')
+            pos++;
+    }
+
+    bool parse_value(JsonValue &value, int depth) {
+        if (depth > max_depth)
+            return fail("exceeded maximum nesting depth");
+
+        skip_whitespace();
+
+        switch (*pos) {
+        case '{':
+            pos++;
+            return parse_object(value, depth);
+        case '[':
+            pos++;
+            return parse_array(value, depth);
+        case '"':
+            pos++;
+            return parse_string(value);
+        case 't':
+            value.value_type = JsonValue::BOOL;
+            value.boolean = true;
+            return expect("true");
+        case 'f':
+            value.value_type = JsonValue::BOOL;
+            value.boolean = false;
+            return expect("false");
+        case 'n':
+            value.value_type = JsonValue::NUL;
+            return expect("null");
+        default:
+            if (*pos == '-' || (*pos >= '0' && *pos <= '9'))
+                return parse_number(value);
+            return fail("expected value, got " + describe(*pos));
+        }
+    }
+
+    bool expect(const char *literal) {
+        size_t length = std::strlen(literal);
+
+        // The text is NUL-terminated, so strncmp can't run off the end.
+        if (std::strncmp(pos, literal, length) != 0)
+            return fail(string("expected ") + literal);
+
+        pos += length;
+        return true;
+    }
+
+    // Moves the members gathered since stack_base into the arena.
+    void close_container(JsonValue &value, JsonValue::Type type, size_t stack_base) {
+        size_t count = stack.size() - stack_base;
+
+        value.value_type = type;
+        value.count = type == JsonValue::OBJECT ? count / 2 : count;
+        value.items = arena;
+
+        arena = std::uninitialized_copy(stack.begin() + stack_base, stack.end(), arena);
+        stack.resize(stack_base);
+    }
+
+    bool parse_array(JsonValue &value, int depth) {
+        size_t stack_base = stack.size();
+
+        skip_whitespace();
+        if (*pos == ']') {
+            pos++;
+            close_container(value, JsonValue::ARRAY, stack_base);
+            return true;
+        }
+
+        for (;;) {
+            JsonValue item;
+            if (!parse_value(item, depth + 1))
+                return false;
+            stack.push_back(item);
+
+            skip_whitespace();
+            if (*pos == ']')
+                break;
+            if (*pos != ',')
+                return fail("expected ',' in list, got " + describe(*pos));
+            pos++;
+        }
+
+        pos++;
+        close_container(value, JsonValue::ARRAY, stack_base);
+        return true;
+    }
+
+    bool parse_object(JsonValue &value, int depth) {
+        size_t stack_base = stack.size();
+
+        skip_whitespace();
+        if (*pos == '}') {
+            pos++;
+            close_container(value, JsonValue::OBJECT, stack_base);
+            return true;
+        }
+
+        for (;;) {
+            if (*pos != '"')
+                return fail("expected '\"' in object, got " + describe(*pos));
+            pos++;
+
+            JsonValue key;
+            if (!parse_string(key))
+                return false;
+            stack.push_back(key);
+
+            skip_whitespace();
+            if (*pos != ':')
+                return fail("expected ':' in object, got " + describe(*pos));
+            pos++;
+
+            JsonValue member;
+            if (!parse_value(member, depth + 1))
+                return false;
+            stack.push_back(member);
+
+            skip_whitespace();
+            if (*pos == '}')
+                break;
+            if (*pos != ',')
+                return fail("expected ',' in object, got " + describe(*pos));
+            pos++;
+            skip_whitespace();
+        }
+
+        pos++;
+        close_container(value, JsonValue::OBJECT, stack_base);
+        return true;
+    }
+
+    static int hex_value(char c) {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    }
+
+    // Reads the four hex digits of a \u escape.
+    bool parse_hex4(long &codepoint) {
+        codepoint = 0;
+        for (int i = 0; i < 4; i++) {
+            int digit = hex_value(pos[i]);
+            if (digit < 0)
+                return fail("bad \\u escape");
+            codepoint = (codepoint << 4) | digit;
+        }
+
+        pos += 4;
+        return true;
+    }
+
+    static char *encode_utf8(long codepoint, char *out) {
+        if (codepoint < 0x80) {
+            *out++ = codepoint;
+        } else if (codepoint < 0x800) {
+            *out++ = (codepoint >> 6) | 0xC0;
+            *out++ = (codepoint & 0x3F) | 0x80;
+        } else if (codepoint < 0x10000) {
+            *out++ = (codepoint >> 12) | 0xE0;
+            *out++ = ((codepoint >> 6) & 0x3F) | 0x80;
+            *out++ = (codepoint & 0x3F) | 0x80;
+        } else {
+            *out++ = (codepoint >> 18) | 0xF0;
+            *out++ = ((codepoint >> 12) & 0x3F) | 0x80;
+            *out++ = ((codepoint >> 6) & 0x3F) | 0x80;
+            *out++ = (codepoint & 0x3F) | 0x80;
+        }
+
+        return out;
+    }
+
+    // Parses a string whose opening quote has been consumed.
+    bool parse_string(JsonValue &value) {
+        char *chars = pos;
+
+        // Most strings have no escapes and need nothing more than a scan.
+        while (*pos != '"' && *pos != '\\' && (unsigned char)*pos >= 0x20)
+            pos++;
+
+        char *out = pos;
+
+        while (*pos != '"') {
+            char c = *pos;
+
+            if ((unsigned char)c < 0x20) {
+                if (pos >= end)
+                    return fail("unexpected end of input in string");
+                return fail("unescaped " + describe(c) + " in string");
+            }
+
+            pos++;
+
+            if (c != '\\') {
+                *out++ = c;
+                continue;
+            }
+
+            c = *pos++;
+            switch (c) {
+            case '"': case '\\': case '/':
+                *out++ = c;
+                break;
+            case 'b': *out++ = '\b'; break;
+            case 'f': *out++ = '\f'; break;
+            case 'n': *out++ = '\n'; break;
+            case 'r': *out++ = '\r'; break;
+            case 't': *out++ = '\t'; break;
+            case 'u': {
+                long codepoint;
+                if (!parse_hex4(codepoint))
+                    return false;
+
+                // Join a surrogate pair into one codepoint. A lone
+                // surrogate is passed through as it is.
+                if (codepoint >= 0xD800 && codepoint <= 0xDBFF && pos[0] == '\\' && pos[1] == 'u') {
+                    long low = 0;
+                    for (int i = 2; i < 6 && low >= 0; i++) {
+                        int digit = hex_value(pos[i]);
+                        low = digit < 0 ? -1 : (low << 4) | digit;
+                    }
+
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        codepoint = (((codepoint - 0xD800) << 10) | (low - 0xDC00)) + 0x10000;
+                        pos += 6;
+                    }
+                }
+
+                out = encode_utf8(codepoint, out);
+                break;
+            }
+            default:
+                pos--;
+                if (pos >= end)
+                    return fail("unexpected end of input in string");
+                return fail("invalid escape character " + describe(c));
+            }
+        }
+
+        *out = '\0';
+        pos++;
+
+        value.value_type = JsonValue::STRING;
+        value.chars = chars;
+        value.count = out - chars;
+        return true;
+    }
+
+    static bool is_digit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    bool parse_number(JsonValue &value) {
+        char *number_start = pos;
+
+        if (*pos == '-')
+            pos++;
+
+        if (*pos == '0') {
+            pos++;
+            if (is_digit(*pos))
+                return fail("leading 0s not permitted in numbers");
+        } else if (is_digit(*pos)) {
+            while (is_digit(*pos))
+                pos++;
+        } else {
+            return fail("invalid " + describe(*pos) + " in number");
+        }
+
+        value.value_type = JsonValue::NUMBER;
+
+        // Plain integers that fit in an int are by far the most common,
+        // and are summed up directly rather than going through strtod.
+        if (*pos != '.' && *pos != 'e' && *pos != 'E' && pos - number_start <= 9) {
+            bool negative = *number_start == '-';
+            int n = 0;
+            for (char *c = number_start + negative; c < pos; c++)
+                n = n * 10 + (*c - '0');
+            value.number = negative ? -n : n;
+            return true;
+        }
+
+        if (*pos == '.') {
+            pos++;
+            if (!is_digit(*pos))
+                return fail("at least one digit required in fractional part");
+            while (is_digit(*pos))
+                pos++;
+        }
+
+        if (*pos == 'e' || *pos == 'E') {
+            pos++;
+            if (*pos == '+' || *pos == '-')
+                pos++;
+            if (!is_digit(*pos))
+                return fail("at least one digit required in exponent");
+            while (is_digit(*pos))
+                pos++;
+        }
+
+        value.number = std::strtod(number_start, nullptr);
+        return true;
+    }
+};
+
+bool JsonDocument::parse(const char *text, size_t length, string &err) {
+    // Every value but the root follows one of these characters, so counting
+    // them bounds the number of values without parsing anything.
+    size_t value_capacity = 0;
+    for (size_t i = 0; i < length; i++) {
+        char c = text[i];
+        value_capacity += (c == ',') + (c == ':') + (c == '[') + (c == '{');
+    }
+
+    size_t text_size = (length + 1 + alignof(JsonValue) - 1) / alignof(JsonValue) * alignof(JsonValue);
+    block_size = text_size + value_capacity * sizeof(JsonValue);
+    block.reset(new char[block_size]);
+
+    char *text_copy = block.get();
+    std::memcpy(text_copy, text, length);
+    text_copy[length] = '\0';
+
+    static thread_local vector<JsonValue> stack;
+    stack.clear();
+
+    JsonValue *arena = reinterpret_cast<JsonValue *>(text_copy + text_size);
+    JsonParser parser(text_copy, length, arena, stack, err);
+
+    root_value = JsonValue();
+    if (!parser.parse_document(root_value)) {
+        root_value = JsonValue();
+        block.reset();
+        block_size = 0;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,143 @@
+// json.h
+
+// The read-only JSON interface mapjson is written against. A JsonDocument
+// owns a single block holding a copy of the parsed text and every value in
+// it; JsonValue, JsonString and JsonArray are views into that block and are
+// only valid while the document is alive.
+
+#ifndef JSON_H
+#define JSON_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+
+class JsonString {
+public:
+    JsonString() : chars(""), length(0) {}
+    JsonString(const char *chars, size_t length) : chars(chars), length(length) {}
+
+    const char *c_str() const { return chars; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    std::string str() const { return std::string(chars, length); }
+    operator std::string() const { return str(); }
+
+private:
+    const char *chars;
+    size_t length;
+};
+
+inline bool operator==(JsonString a, JsonString b) {
+    return a.size() == b.size() && std::memcmp(a.c_str(), b.c_str(), a.size()) == 0;
+}
+
+inline bool operator==(JsonString a, const char *b) {
+    return a == JsonString(b, std::strlen(b));
+}
+
+inline bool operator!=(JsonString a, JsonString b) { return !(a == b); }
+inline bool operator!=(JsonString a, const char *b) { return !(a == b); }
+
+inline std::ostream &operator<<(std::ostream &out, JsonString s) {
+    return out.write(s.c_str(), s.size());
+}
+
+inline std::string operator+(JsonString a, const char *b) { return a.str() + b; }
+inline std::string operator+(const std::string &a, JsonString b) { return std::string(a).append(b.c_str(), b.size()); }
+
+namespace std {
+    template <> struct hash<JsonString> {
+        size_t operator()(JsonString s) const {
+            // FNV-1a
+            size_t h = 2166136261u;
+            for (size_t i = 0; i < s.size(); i++)
+                h = (h ^ (unsigned char)s.c_str()[i]) * 16777619u;
+            return h;
+        }
+    };
+}
+
+class JsonValue;
+
+class JsonArray {
+public:
+    JsonArray(const JsonValue *first, size_t count) : first(first), count(count) {}
+
+    const JsonValue *begin() const { return first; }
+    const JsonValue *end() const;
+    size_t size() const { return count; }
+    const JsonValue &operator[](size_t i) const;
+
+private:
+    const JsonValue *first;
+    size_t count;
+};
+
+class JsonValue {
+public:
+    enum Type : uint8_t { NUL, NUMBER, BOOL, STRING, ARRAY, OBJECT };
+
+    JsonValue() : value_type(NUL), count(0), number(0) {}
+
+    Type type() const { return value_type; }
+    bool is_null() const { return value_type == NUL; }
+
+    // A value of the wrong type reads as 0, false, "" or an empty array,
+    // and looking up a missing key or index gives null.
+    double number_value() const { return value_type == NUMBER ? number : 0; }
+    int int_value() const { return (int)number_value(); }
+    bool bool_value() const { return value_type == BOOL && boolean; }
+    JsonString string_value() const { return value_type == STRING ? JsonString(chars, count) : JsonString(); }
+    JsonArray array_items() const { return JsonArray(value_type == ARRAY ? items : nullptr, value_type == ARRAY ? count : 0); }
+
+    bool has_key(const char *key) const { return find(key, std::strlen(key)) != nullptr; }
+
+    const JsonValue &operator[](size_t i) const;
+    const JsonValue &operator[](const char *key) const;
+    const JsonValue &operator[](const std::string &key) const;
+    const JsonValue &operator[](JsonString key) const;
+
+private:
+    friend class JsonParser;
+
+    const JsonValue *find(const char *key, size_t length) const;
+
+    Type value_type;
+    // String length, array size, or number of object members.
+    uint32_t count;
+    union {
+        double number;
+        bool boolean;
+        const char *chars;
+        // Arrays point at their elements, objects at key, value pairs.
+        const JsonValue *items;
+    };
+};
+
+inline const JsonValue *JsonArray::end() const { return first + count; }
+inline const JsonValue &JsonArray::operator[](size_t i) const { return first[i]; }
+
+class JsonDocument {
+public:
+    JsonDocument() : block_size(0) {}
+
+    // Parses a copy of text. On failure, returns false with a message in
+    // err and leaves the root null.
+    bool parse(const char *text, size_t length, std::string &err);
+    bool parse(const std::string &text, std::string &err) { return parse(text.data(), text.size(), err); }
+
+    const JsonValue &root() const { return root_value; }
+    size_t allocated_bytes() const { return block_size; }
+
+private:
+    std::unique_ptr<char[]> block;
+    size_t block_size;
+    JsonValue root_value;
+};
+
+#endif // JSON_H
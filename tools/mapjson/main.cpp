@@ -0,0 +1,83 @@
+// main.cpp
+
+#include <iostream>
+using std::cout; using std::endl;
+
+#include <cstdlib>
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+#include "mapjson.h"
+
+int main(int argc, char *argv[]) {
+    if (argc < 3)
+        FATAL_ERROR("USAGE: mapjson <mode> <game-version> [options]\n");
+
+    char *version_arg = argv[2];
+    string version(version_arg);
+    if (version != "emerald" && version != "ruby")
+        FATAL_ERROR("ERROR: <game-version> must be 'emerald' or 'ruby'.\n");
+
+    char *mode_arg = argv[1];
+    string mode(mode_arg);
+    if (mode != "layouts" && mode != "map" && mode != "maps" && mode != "groups")
+        FATAL_ERROR("ERROR: <mode> must be 'layouts', 'map', 'maps', or 'groups'.\n");
+
+    if (mode == "map") {
+        if (argc != 5)
+            FATAL_ERROR("USAGE: mapjson map <game-version> <map_file> <layouts_file>\n");
+
+        string filepath(argv[3]);
+        string layouts_filepath(argv[4]);
+
+        process_map(filepath, layouts_filepath, version);
+    }
+    else if (mode == "maps") {
+        if (argc < 4)
+            FATAL_ERROR("USAGE: mapjson maps <game-version> <layouts_file> [-j <jobs>] [--cache <cache_file>] <map_file>...\n");
+
+        string layouts_filepath(argv[3]);
+        string cache_filepath;
+        int job_count = 0;
+        int first_map = 4;
+
+        for (;;) {
+            if (argc >= first_map + 2 && string(argv[first_map]) == "-j")
+                job_count = std::atoi(argv[first_map + 1]);
+            else if (argc >= first_map + 2 && string(argv[first_map]) == "--cache")
+                cache_filepath = argv[first_map + 1];
+            else
+                break;
+            first_map += 2;
+        }
+
+        vector<string> filepaths(argv + first_map, argv + argc);
+
+        process_maps(filepaths, layouts_filepath, version, job_count, cache_filepath);
+    }
+    else if (mode == "groups") {
+        if (argc != 4 && !(argc == 6 && string(argv[4]) == "--cache"))
+            FATAL_ERROR("USAGE: mapjson groups <game-version> <groups_file> [--cache <cache_file>]\n");
+
+        string filepath(argv[3]);
+        string cache_filepath(argc == 6 ? argv[5] : "");
+
+        process_groups(filepath, cache_filepath);
+    }
+    else if (mode == "layouts") {
+        if (argc != 4)
+            FATAL_ERROR("USAGE: mapjson layouts <game-version> <layouts_file>\n");
+
+        string filepath(argv[3]);
+
+        process_layouts(filepath);
+    }
+
+    cout << "mapjson: wrote " << files_written << " of " << files_written + files_unchanged << " files" << endl;
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Benchmarks regenerating every map, group and layout output in memory, so
+// that only JSON parsing and text generation are timed. The map constants
+// are left out, since generating them reads every map.json from disk.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "mapjson.h"
+
+using std::string;
+using std::vector;
+
+static void parse(JsonDocument &document, const string &text, const string &filepath) {
+    string err;
+
+    if (!document.parse(text, err))
+        FATAL_ERROR("%s: %s\n", filepath.c_str(), err.c_str());
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = 20;
+    vector<string> filepaths;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-n") == 0) {
+            if (i + 1 >= argc || (iterations = std::atoi(argv[i + 1])) < 1)
+                FATAL_ERROR("Expected a positive number of iterations following \"-n\".\n");
+            i++;
+        } else {
+            filepaths.push_back(argv[i]);
+        }
+    }
+
+    if (filepaths.size() < 3)
+        FATAL_ERROR("USAGE: map_bench [-n <iterations>] <layouts_file> <groups_file> <map_file>...\n");
+
+    vector<string> texts;
+    size_t total_bytes = 0;
+
+    for (const string &filepath : filepaths) {
+        texts.push_back(read_text_file(filepath));
+        total_bytes += texts.back().size();
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::duration parse_time = Clock::duration::zero();
+    Clock::duration generate_time = Clock::duration::zero();
+    size_t output_bytes = 0;
+    size_t allocated_bytes = 0;
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        Clock::time_point start = Clock::now();
+
+        vector<JsonDocument> documents(texts.size());
+        for (size_t i = 0; i < texts.size(); i++)
+            parse(documents[i], texts[i], filepaths[i]);
+
+        Clock::time_point parsed = Clock::now();
+
+        const JsonValue &layouts_data = documents[0].root();
+        const JsonValue &groups_data = documents[1].root();
+        LayoutIndex layouts = index_layouts(layouts_data);
+        output_bytes = 0;
+        allocated_bytes = 0;
+
+        for (const JsonDocument &document : documents)
+            allocated_bytes += document.allocated_bytes();
+
+        for (size_t i = 2; i < documents.size(); i++) {
+            MapTexts map_texts = generate_map_texts(documents[i].root(), layouts, "emerald");
+            output_bytes += map_texts.header.size() + map_texts.events.size() + map_texts.connections.size();
+        }
+
+        output_bytes += generate_groups_text(groups_data).size();
+        output_bytes += generate_connections_text(groups_data).size();
+        output_bytes += generate_headers_text(groups_data).size();
+        output_bytes += generate_events_text(groups_data).size();
+        output_bytes += generate_layout_headers_text(layouts_data).size();
+        output_bytes += generate_layouts_table_text(layouts_data).size();
+        output_bytes += generate_layouts_constants_text(layouts_data).size();
+
+        Clock::time_point generated = Clock::now();
+        parse_time += parsed - start;
+        generate_time += generated - parsed;
+    }
+
+    double parse_ms = std::chrono::duration<double, std::milli>(parse_time).count() / iterations;
+    double generate_ms = std::chrono::duration<double, std::milli>(generate_time).count() / iterations;
+
+    std::printf("%zu files, %.1f KiB of JSON, %.1f KiB of output, %d iterations\n",
+                filepaths.size(), total_bytes / 1024.0, output_bytes / 1024.0, iterations);
+    std::printf("parse:    %8.3f ms/iteration  %7.1f MiB/s  %.1f KiB in %zu blocks\n", parse_ms,
+                total_bytes / (1024.0 * 1024.0) / (parse_ms / 1000), allocated_bytes / 1024.0, filepaths.size());
+    std::printf("generate: %8.3f ms/iteration\n", generate_ms);
+    std::printf("total:    %8.3f ms/iteration\n", parse_ms + generate_ms);
+
+    return 0;
+}
@@ -0,0 +1,213 @@
+// map_cache.cpp
+
+#include <sys/stat.h>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mapjson.h"
+#include "map_cache.h"
+
+using std::string;
+
+// The cache file is a header followed by one record per map:
+//
+//   "MAPCACHE" <version:u32> <count:u32>
+//   <path> <size:u64> <mtime_sec:i64> <mtime_nsec:i64>
+//   <name> <id> <layout> <connection count:u32>
+//   (<direction> <offset:i32> <map>)...
+//
+// Strings are a u32 length followed by their bytes. All integers are little
+// endian. A file with a different version is ignored and rebuilt.
+static const char cache_magic[8] = { 'M', 'A', 'P', 'C', 'A', 'C', 'H', 'E' };
+static const uint32_t cache_version = 1;
+
+bool get_file_stamp(const string &filepath, FileStamp &stamp) {
+    struct stat st;
+
+    if (stat(filepath.c_str(), &st) != 0)
+        return false;
+
+    stamp.size = st.st_size;
+    stamp.mtime_sec = st.st_mtime;
+#if defined(__APPLE__)
+    stamp.mtime_nsec = st.st_mtimespec.tv_nsec;
+#elif defined(_WIN32)
+    stamp.mtime_nsec = 0;
+#else
+    stamp.mtime_nsec = st.st_mtim.tv_nsec;
+#endif
+
+    return true;
+}
+
+MapInfo get_map_info(const JsonValue &map_data) {
+    MapInfo info;
+    info.name = map_data["name"].string_value();
+    info.id = map_data["id"].string_value();
+    info.layout = map_data["layout"].string_value();
+
+    for (auto &connection : map_data["connections"].array_items()) {
+        MapConnection map_connection;
+        map_connection.direction = connection["direction"].string_value();
+        map_connection.offset = connection["offset"].int_value();
+        map_connection.map = connection["map"].string_value();
+        info.connections.push_back(map_connection);
+    }
+
+    return info;
+}
+
+static void put_u32(string &out, uint32_t value) {
+    for (int i = 0; i < 4; i++)
+        out += (char)(value >> (8 * i));
+}
+
+static void put_u64(string &out, uint64_t value) {
+    for (int i = 0; i < 8; i++)
+        out += (char)(value >> (8 * i));
+}
+
+static void put_string(string &out, const string &value) {
+    put_u32(out, value.size());
+    out += value;
+}
+
+// Reads values back out of a cache file, failing (rather than reading past
+// the end) if it has been truncated.
+class CacheReader {
+public:
+    CacheReader(const string &data, size_t pos) : data(data), pos(pos), ok(true) {}
+
+    bool good() const { return ok; }
+    bool at_end() const { return pos == data.size(); }
+
+    uint32_t get_u32() {
+        return get_bytes(4);
+    }
+
+    uint64_t get_u64() {
+        return get_bytes(8);
+    }
+
+    string get_string() {
+        uint32_t length = get_u32();
+        if (!ok || data.size() - pos < length) {
+            ok = false;
+            return string();
+        }
+
+        pos += length;
+        return data.substr(pos - length, length);
+    }
+
+private:
+    const string &data;
+    size_t pos;
+    bool ok;
+
+    uint64_t get_bytes(int count) {
+        if (!ok || data.size() - pos < (size_t)count) {
+            ok = false;
+            return 0;
+        }
+
+        uint64_t value = 0;
+        for (int i = 0; i < count; i++)
+            value |= (uint64_t)(unsigned char)data[pos++] << (8 * i);
+
+        return value;
+    }
+};
+
+MapCache read_map_cache(const string &filepath) {
+    MapCache cache;
+    std::ifstream in_file(filepath, std::ifstream::binary);
+
+    if (!in_file.is_open())
+        return cache;
+
+    std::ostringstream contents;
+    contents << in_file.rdbuf();
+    string data = contents.str();
+
+    if (data.size() < sizeof(cache_magic) || std::memcmp(data.data(), cache_magic, sizeof(cache_magic)) != 0)
+        return cache;
+
+    CacheReader reader(data, sizeof(cache_magic));
+
+    if (reader.get_u32() != cache_version)
+        return cache;
+
+    uint32_t count = reader.get_u32();
+
+    for (uint32_t i = 0; i < count && reader.good(); i++) {
+        string path = reader.get_string();
+        MapCacheEntry entry;
+        entry.stamp.size = reader.get_u64();
+        entry.stamp.mtime_sec = reader.get_u64();
+        entry.stamp.mtime_nsec = reader.get_u64();
+        entry.info.name = reader.get_string();
+        entry.info.id = reader.get_string();
+        entry.info.layout = reader.get_string();
+
+        uint32_t connection_count = reader.get_u32();
+        for (uint32_t j = 0; j < connection_count && reader.good(); j++) {
+            MapConnection connection;
+            connection.direction = reader.get_string();
+            connection.offset = (int32_t)reader.get_u32();
+            connection.map = reader.get_string();
+            entry.info.connections.push_back(connection);
+        }
+
+        cache[path] = entry;
+    }
+
+    if (!reader.good() || !reader.at_end())
+        cache.clear();
+
+    return cache;
+}
+
+void write_map_cache(const string &filepath, const MapCache &cache) {
+    string out(cache_magic, sizeof(cache_magic));
+    put_u32(out, cache_version);
+    put_u32(out, cache.size());
+
+    for (auto &item : cache) {
+        const MapCacheEntry &entry = item.second;
+        put_string(out, item.first);
+        put_u64(out, entry.stamp.size);
+        put_u64(out, entry.stamp.mtime_sec);
+        put_u64(out, entry.stamp.mtime_nsec);
+        put_string(out, entry.info.name);
+        put_string(out, entry.info.id);
+        put_string(out, entry.info.layout);
+        put_u32(out, entry.info.connections.size());
+
+        for (const MapConnection &connection : entry.info.connections) {
+            put_string(out, connection.direction);
+            put_u32(out, connection.offset);
+            put_string(out, connection.map);
+        }
+    }
+
+    write_text_file(filepath, out);
+}
+
+const MapInfo *find_map_info(const MapCache &cache, const string &map_filepath) {
+    auto match = cache.find(map_filepath);
+    FileStamp stamp;
+
+    if (match == cache.end() || !get_file_stamp(map_filepath, stamp))
+        return nullptr;
+
+    const FileStamp &cached = match->second.stamp;
+    if (cached.size != stamp.size || cached.mtime_sec != stamp.mtime_sec || cached.mtime_nsec != stamp.mtime_nsec)
+        return nullptr;
+
+    return &match->second.info;
+}
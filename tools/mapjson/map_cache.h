@@ -0,0 +1,54 @@
+// map_cache.h
+
+#ifndef MAP_CACHE_H
+#define MAP_CACHE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "json.h"
+
+struct MapConnection {
+    std::string direction;
+    int offset;
+    std::string map;
+};
+
+// What other outputs need to know about a map, so that they don't have to
+// parse its map.json again.
+struct MapInfo {
+    std::string name;
+    std::string id;
+    std::string layout;
+    std::vector<MapConnection> connections;
+};
+
+// Identifies the version of a map.json that an entry was made from.
+struct FileStamp {
+    uint64_t size;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+};
+
+struct MapCacheEntry {
+    FileStamp stamp;
+    MapInfo info;
+};
+
+// Entries by the path of their map.json.
+typedef std::map<std::string, MapCacheEntry> MapCache;
+
+bool get_file_stamp(const std::string &filepath, FileStamp &stamp);
+MapInfo get_map_info(const JsonValue &map_data);
+
+// A cache file that is missing or unreadable reads as empty.
+MapCache read_map_cache(const std::string &filepath);
+void write_map_cache(const std::string &filepath, const MapCache &cache);
+
+// Finds the info for a map.json, if the cache holds an entry for it that is
+// still up to date.
+const MapInfo *find_map_info(const MapCache &cache, const std::string &map_filepath);
+
+#endif // MAP_CACHE_H
@@ -10,11 +10,20 @@ using std::string;
 using std::vector;
 
 #include <algorithm>
-using std::sort; using std::find;
+using std::sort;
 
 #include <map>
 using std::map;
 
+#include <unordered_map>
+using std::unordered_map;
+
+#include <atomic>
+using std::atomic;
+
+#include <thread>
+using std::thread;
+
 #include <fstream>
 using std::ofstream; using std::ifstream;
 
@@ -24,13 +33,10 @@ using std::ostringstream;
 #include <limits>
 using std::numeric_limits;
 
-#include "json11.h"
-using json11::Json;
-
 #include "mapjson.h"
 
 
-string read_text_file(string filepath) {
+string read_text_file(const string &filepath) {
     ifstream in_file(filepath);
 
     if (!in_file.is_open())
@@ -49,7 +55,36 @@ string read_text_file(string filepath) {
     return text;
 }
 
-void write_text_file(string filepath, string text) {
+int files_written = 0;
+int files_unchanged = 0;
+
+bool file_has_text(const string &filepath, const string &text) {
+    ifstream in_file(filepath, std::ifstream::binary);
+
+    if (!in_file.is_open())
+        return false;
+
+    in_file.seekg(0, std::ios::end);
+    if (in_file.tellg() != (std::streamoff)text.size())
+        return false;
+
+    string existing(text.size(), '\0');
+    in_file.seekg(0, std::ios::beg);
+    in_file.read(&existing[0], existing.size());
+
+    return in_file && existing == text;
+}
+
+// Leaves a file that already holds the text alone, so its timestamp doesn't
+// make everything built from it look out of date.
+void write_text_file(const string &filepath, const string &text) {
+    if (file_has_text(filepath, text)) {
+        files_unchanged++;
+        return;
+    }
+
+    files_written++;
+
     ofstream out_file(filepath, std::ofstream::binary);
 
     if (!out_file.is_open())
@@ -60,20 +95,37 @@ void write_text_file(string filepath, string text) {
     out_file.close();
 }
 
-string generate_map_header_text(Json map_data, Json layouts_data, string version) {
-    string map_layout_id = map_data["layout"].string_value();
+JsonDocument parse_json_file(const string &filepath) {
+    string err;
+    JsonDocument document;
+
+    if (!document.parse(read_text_file(filepath), err))
+        FATAL_ERROR("%s: %s\n", filepath.c_str(), err.c_str());
+
+    return document;
+}
 
-    vector<Json> matched;
+LayoutIndex index_layouts(const JsonValue &layouts_data) {
+    LayoutIndex index;
 
-    for (auto &field : layouts_data["layouts"].array_items()) {
-        if (map_layout_id == field["id"].string_value())
-            matched.push_back(field);
+    for (auto &layout : layouts_data["layouts"].array_items()) {
+        auto result = index.emplace(layout["id"].string_value(), &layout);
+        if (!result.second)
+            result.first->second = nullptr;
     }
 
-    if (matched.size() != 1)
+    return index;
+}
+
+string generate_map_header_text(const JsonValue &map_data, const LayoutIndex &layouts, const string &version) {
+    JsonString map_layout_id = map_data["layout"].string_value();
+
+    auto match = layouts.find(map_layout_id);
+
+    if (match == layouts.end() || !match->second)
         FATAL_ERROR("Failed to find matching layout for %s.\n", map_layout_id.c_str());
 
-    Json layout = matched[0];
+    const JsonValue &layout = *match->second;
 
     ostringstream text;
 
@@ -84,17 +136,17 @@ string generate_map_header_text(Json map_data, Json layouts_data, string version
     text << map_data["name"].string_value() << ":\n"
          << "\t.4byte " << layout["name"].string_value() << "\n";
 
-    if (map_data.object_items().find("shared_events_map") != map_data.object_items().end())
+    if (map_data.has_key("shared_events_map"))
         text << "\t.4byte " << map_data["shared_events_map"].string_value() << "_MapEvents\n";
     else
         text << "\t.4byte " << map_data["name"].string_value() << "_MapEvents\n";
 
-    if (map_data.object_items().find("shared_scripts_map") != map_data.object_items().end())
+    if (map_data.has_key("shared_scripts_map"))
         text << "\t.4byte " << map_data["shared_scripts_map"].string_value() << "_MapScripts\n";
     else
         text << "\t.4byte " << map_data["name"].string_value() << "_MapScripts\n";
 
-    if (map_data.object_items().find("connections") != map_data.object_items().end()
+    if (map_data.has_key("connections")
      && map_data["connections"].array_items().size() > 0)
         text << "\t.4byte " << map_data["name"].string_value() << "_MapConnections\n";
     else
@@ -122,8 +174,8 @@ string generate_map_header_text(Json map_data, Json layouts_data, string version
     return text.str();
 }
 
-string generate_map_connections_text(Json map_data) {
-    if (map_data["connections"] == Json())
+string generate_map_connections_text(const JsonValue &map_data) {
+    if (map_data["connections"].is_null())
         return string("\n");
 
     ostringstream text;
@@ -148,8 +200,8 @@ string generate_map_connections_text(Json map_data) {
     return text.str();
 }
 
-string generate_map_events_text(Json map_data) {
-    if (map_data.object_items().find("shared_events_map") != map_data.object_items().end())
+string generate_map_events_text(const JsonValue &map_data) {
+    if (map_data.has_key("shared_events_map"))
         return string("\n");
 
     ostringstream text;
@@ -163,8 +215,9 @@ string generate_map_events_text(Json map_data) {
     if (map_data["object_events"].array_items().size() > 0) {
         objects_label = map_data["name"].string_value() + "_ObjectEvents";
         text << objects_label << ":\n";
-        for (unsigned int i = 0; i < map_data["object_events"].array_items().size(); i++) {
-            auto obj_event = map_data["object_events"].array_items()[i];
+        JsonArray object_events = map_data["object_events"].array_items();
+        for (unsigned int i = 0; i < object_events.size(); i++) {
+            const JsonValue &obj_event = object_events[i];
             text << "\tobject_event " << i + 1 << ", "
                  << obj_event["graphics_id"].string_value() << ", 0, "
                  << obj_event["x"].int_value() << ", "
@@ -212,7 +265,7 @@ string generate_map_events_text(Json map_data) {
                      << coord_event["var_value"].string_value() << ", "
                      << coord_event["script"].string_value() << "\n";
             }
-            else if (coord_event["type"] == "weather") {
+            else if (coord_event["type"].string_value() == "weather") {
                 text << "\tcoord_weather_event "
                      << coord_event["x"].int_value() << ", "
                      << coord_event["y"].int_value() << ", "
@@ -229,7 +282,7 @@ string generate_map_events_text(Json map_data) {
         bgs_label = map_data["name"].string_value() + "_MapBGEvents";
         text << bgs_label << ":\n";
         for (auto &bg_event : map_data["bg_events"].array_items()) {
-            if (bg_event["type"] == "sign") {
+            if (bg_event["type"].string_value() == "sign") {
                 text << "\tbg_sign_event "
                      << bg_event["x"].int_value() << ", "
                      << bg_event["y"].int_value() << ", "
@@ -237,7 +290,7 @@ string generate_map_events_text(Json map_data) {
                      << bg_event["player_facing_dir"].string_value() << ", "
                      << bg_event["script"].string_value() << "\n";
             }
-            else if (bg_event["type"] == "hidden_item") {
+            else if (bg_event["type"].string_value() == "hidden_item") {
                 text << "\tbg_hidden_item_event "
                      << bg_event["x"].int_value() << ", "
                      << bg_event["y"].int_value() << ", "
@@ -245,7 +298,7 @@ string generate_map_events_text(Json map_data) {
                      << bg_event["item"].string_value() << ", "
                      << bg_event["flag"].string_value() << "\n";
             }
-            else if (bg_event["type"] == "secret_base") {
+            else if (bg_event["type"].string_value() == "secret_base") {
                 text << "\tbg_secret_base_event "
                      << bg_event["x"].int_value() << ", "
                      << bg_event["y"].int_value() << ", "
@@ -265,46 +318,91 @@ string generate_map_events_text(Json map_data) {
     return text.str();
 }
 
-string get_directory_name(string filename) {
+string get_directory_name(const string &filename) {
     size_t dir_pos = filename.find_last_of("/\\");
 
     return filename.substr(0, dir_pos + 1);
 }
 
-void process_map(string map_filepath, string layouts_filepath, string version) {
-    string mapdata_err, layouts_err;
+MapTexts generate_map_texts(const JsonValue &map_data, const LayoutIndex &layouts, const string &version) {
+    MapTexts texts;
+    texts.header = generate_map_header_text(map_data, layouts, version);
+    texts.events = generate_map_events_text(map_data);
+    texts.connections = generate_map_connections_text(map_data);
 
-    string mapdata_json_text = read_text_file(map_filepath);
-    string layouts_json_text = read_text_file(layouts_filepath);
+    return texts;
+}
 
-    Json map_data = Json::parse(mapdata_json_text, mapdata_err);
-    if (map_data == Json())
-        FATAL_ERROR("%s\n", mapdata_err.c_str());
+void write_map_texts(const string &map_filepath, const MapTexts &texts) {
+    string files_dir = get_directory_name(map_filepath);
+    write_text_file(files_dir + "header.inc", texts.header);
+    write_text_file(files_dir + "events.inc", texts.events);
+    write_text_file(files_dir + "connections.inc", texts.connections);
+}
 
-    Json layouts_data = Json::parse(layouts_json_text, layouts_err);
-    if (layouts_data == Json())
-        FATAL_ERROR("%s\n", layouts_err.c_str());
+void process_map(const string &map_filepath, const string &layouts_filepath, const string &version) {
+    JsonDocument layouts_document = parse_json_file(layouts_filepath);
+    LayoutIndex layouts = index_layouts(layouts_document.root());
 
-    string header_text = generate_map_header_text(map_data, layouts_data, version);
-    string events_text = generate_map_events_text(map_data);
-    string connections_text = generate_map_connections_text(map_data);
+    write_map_texts(map_filepath, generate_map_texts(parse_json_file(map_filepath).root(), layouts, version));
+}
 
-    string files_dir = get_directory_name(map_filepath);
-    write_text_file(files_dir + "header.inc", header_text);
-    write_text_file(files_dir + "events.inc", events_text);
-    write_text_file(files_dir + "connections.inc", connections_text);
+// Processes many maps against one parse of the layouts, spread over
+// job_count threads. Nothing is written until every map has been generated,
+// so a map with an error leaves all the outputs as they were. With a
+// cache_filepath, the maps' entries in that cache are brought up to date.
+void process_maps(const vector<string> &map_filepaths, const string &layouts_filepath, const string &version, int job_count, const string &cache_filepath) {
+    JsonDocument layouts_document = parse_json_file(layouts_filepath);
+    LayoutIndex layouts = index_layouts(layouts_document.root());
+    vector<MapTexts> texts(map_filepaths.size());
+    vector<MapCacheEntry> cache_entries(map_filepaths.size());
+    atomic<size_t> next_map(0);
+
+    auto worker = [&]() {
+        for (size_t i = next_map++; i < map_filepaths.size(); i = next_map++) {
+            // Stamped before reading, so a map.json that changes in
+            // between looks out of date rather than up to date.
+            get_file_stamp(map_filepaths[i], cache_entries[i].stamp);
+            JsonDocument map_document = parse_json_file(map_filepaths[i]);
+            texts[i] = generate_map_texts(map_document.root(), layouts, version);
+            cache_entries[i].info = get_map_info(map_document.root());
+        }
+    };
+
+    if (job_count <= 0)
+        job_count = thread::hardware_concurrency();
+    if (job_count <= 0)
+        job_count = 1;
+    if ((size_t)job_count > map_filepaths.size())
+        job_count = map_filepaths.size();
+
+    vector<thread> threads;
+    for (int i = 1; i < job_count; i++)
+        threads.emplace_back(worker);
+    worker();
+    for (thread &t : threads)
+        t.join();
+
+    for (size_t i = 0; i < map_filepaths.size(); i++)
+        write_map_texts(map_filepaths[i], texts[i]);
+
+    if (!cache_filepath.empty()) {
+        MapCache cache = read_map_cache(cache_filepath);
+        for (size_t i = 0; i < map_filepaths.size(); i++)
+            cache[map_filepaths[i]] = cache_entries[i];
+        write_map_cache(cache_filepath, cache);
+    }
 }
 
-string generate_groups_text(Json groups_data) {
+string generate_groups_text(const JsonValue &groups_data) {
     ostringstream text;
 
     text << "@\n@ DO NOT MODIFY THIS FILE! It is auto-generated from data/maps/map_groups.json\n@\n\n";
 
     for (auto &key : groups_data["group_order"].array_items()) {
-        string group = key.string_value();
+        JsonString group = key.string_value();
         text << group << "::\n";
-        auto maps = groups_data[group].array_items();
-        for (Json &map_name : maps)
+        for (auto &map_name : groups_data[group].array_items())
             text << "\t.4byte " << map_name.string_value() << "\n";
         text << "\n";
     }
@@ -317,71 +415,73 @@ string generate_groups_text(Json groups_data) {
     return text.str();
 }
 
-string generate_connections_text(Json groups_data) {
-    vector<Json> map_names;
+string generate_connections_text(const JsonValue &groups_data) {
+    vector<JsonString> map_names;
 
     for (auto &group : groups_data["group_order"].array_items())
-    for (auto map_name : groups_data[group.string_value()].array_items())
-        map_names.push_back(map_name);
-
-    vector<Json> connections_include_order = groups_data["connections_include_order"].array_items();
-
-    if (connections_include_order.size() > 0)
-        sort(map_names.begin(), map_names.end(), [connections_include_order](const Json &a, const Json &b) {
-            auto iter_a = find(connections_include_order.begin(), connections_include_order.end(), a);
-            if (iter_a == connections_include_order.end())
-                iter_a = connections_include_order.begin() + numeric_limits<int>::max();
-            auto iter_b = find(connections_include_order.begin(), connections_include_order.end(), b);
-            if (iter_b == connections_include_order.end())
-                iter_b = connections_include_order.begin() + numeric_limits<int>::max();
-            return iter_a < iter_b;
+    for (auto &map_name : groups_data[group.string_value()].array_items())
+        map_names.push_back(map_name.string_value());
+
+    JsonArray connections_include_order = groups_data["connections_include_order"].array_items();
+
+    if (connections_include_order.size() > 0) {
+        // Each map's position in the include order, by its first appearance.
+        // Maps that aren't listed all sort after the listed ones.
+        unordered_map<JsonString, int> rank;
+        for (size_t i = 0; i < connections_include_order.size(); i++)
+            rank.emplace(connections_include_order[i].string_value(), i);
+
+        auto get_rank = [&rank](JsonString map_name) {
+            auto iter = rank.find(map_name);
+            return iter != rank.end() ? iter->second : numeric_limits<int>::max();
+        };
+
+        sort(map_names.begin(), map_names.end(), [&get_rank](JsonString a, JsonString b) {
+            return get_rank(a) < get_rank(b);
         });
+    }
 
     ostringstream text;
 
     text << "@\n@ DO NOT MODIFY THIS FILE! It is auto-generated from data/maps/map_groups.json\n@\n\n";
 
-    for (Json map_name : map_names)
-        text << "\t.include \"data/maps/" << map_name.string_value() << "/connections.inc\"\n";
+    for (JsonString map_name : map_names)
+        text << "\t.include \"data/maps/" << map_name << "/connections.inc\"\n";
 
     return text.str();
 }
 
-string generate_headers_text(Json groups_data) {
-    vector<string> map_names;
-
-    for (auto &group : groups_data["group_order"].array_items())
-    for (auto map_name : groups_data[group.string_value()].array_items())
-        map_names.push_back(map_name.string_value());
-
+string generate_headers_text(const JsonValue &groups_data) {
     ostringstream text;
 
     text << "@\n@ DO NOT MODIFY THIS FILE! It is auto-generated from data/maps/map_groups.json\n@\n\n";
 
-    for (string map_name : map_names)
+    for (auto &group : groups_data["group_order"].array_items())
+    for (auto &map_name_json : groups_data[group.string_value()].array_items()) {
+        JsonString map_name = map_name_json.string_value();
         text << "\t.include \"data/maps/" << map_name << "/header.inc\"\n";
+    }
 
     return text.str();
 }
 
-string generate_events_text(Json groups_data) {
-    vector<string> map_names;
-
-    for (auto &group : groups_data["group_order"].array_items())
-    for (auto map_name : groups_data[group.string_value()].array_items())
-        map_names.push_back(map_name.string_value());
-
+string generate_events_text(const JsonValue &groups_data) {
     ostringstream text;
 
     text << "@\n@ DO NOT MODIFY THIS FILE! It is auto-generated from data/maps/map_groups.json\n@\n\n";
 
-    for (string map_name : map_names)
+    for (auto &group : groups_data["group_order"].array_items())
+    for (auto &map_name_json : groups_data[group.string_value()].array_items()) {
+        JsonString map_name = map_name_json.string_value();
         text << "\t.include \"data/maps/" << map_name << "/events.inc\"\n";
+    }
 
     return text.str();
 }
 
-string generate_map_constants_text(string groups_filepath, Json groups_data) {
+// Each map's id comes from the cache where it's up to date, and otherwise
+// from parsing its map.json.
+string generate_map_constants_text(const string &groups_filepath, const JsonValue &groups_data, const MapCache &cache) {
     string file_dir = get_directory_name(groups_filepath);
     char dir_separator = file_dir.back();
 
@@ -396,21 +496,27 @@ string generate_map_constants_text(string groups_filepath, Json groups_data) {
 
     for (auto &group : groups_data["group_order"].array_items()) {
         text << "// " << group.string_value() << "\n";
-        vector<Json> map_ids;
+        vector<string> map_ids;
         size_t max_length = 0;
 
         for (auto &map_name : groups_data[group.string_value()].array_items()) {
             string header_filepath = file_dir + map_name.string_value() + dir_separator + "map.json";
-            string err_str;
-            Json map_data = Json::parse(read_text_file(header_filepath), err_str);
-            map_ids.push_back(map_data["id"]);
-            if (map_data["id"].string_value().length() > max_length)
-                max_length = map_data["id"].string_value().length();
+            const MapInfo *info = find_map_info(cache, header_filepath);
+            if (info) {
+                map_ids.push_back(info->id);
+            } else {
+                string err_str;
+                JsonDocument map_document;
+                map_document.parse(read_text_file(header_filepath), err_str);
+                map_ids.push_back(map_document.root()["id"].string_value());
+            }
+            if (map_ids.back().length() > max_length)
+                max_length = map_ids.back().length();
         }
 
         int map_id_num = 0;
-        for (Json map_id : map_ids) {
-            text << "#define " << map_id.string_value() << string((max_length - map_id.string_value().length() + 1), ' ')
+        for (const string &map_id : map_ids) {
+            text << "#define " << map_id << string((max_length - map_id.length() + 1), ' ')
                  << "(" << map_id_num++ << " | (" << group_num << " << 8))\n";
         }
         text << "\n";
@@ -424,18 +530,18 @@ string generate_map_constants_text(string groups_filepath, Json groups_data) {
     return text.str();
 }
 
-void process_groups(string groups_filepath) {
-    string err;
-    Json groups_data = Json::parse(read_text_file(groups_filepath), err);
-
-    if (groups_data == Json())
-        FATAL_ERROR("%s\n", err.c_str());
+void process_groups(const string &groups_filepath, const string &cache_filepath) {
+    JsonDocument groups_document = parse_json_file(groups_filepath);
+    const JsonValue &groups_data = groups_document.root();
 
     string groups_text = generate_groups_text(groups_data);
     string connections_text = generate_connections_text(groups_data);
     string headers_text = generate_headers_text(groups_data);
     string events_text = generate_events_text(groups_data);
-    string map_header_text = generate_map_constants_text(groups_filepath, groups_data);
+    MapCache cache;
+    if (!cache_filepath.empty())
+        cache = read_map_cache(cache_filepath);
+    string map_header_text = generate_map_constants_text(groups_filepath, groups_data, cache);
 
     string file_dir = get_directory_name(groups_filepath);
     char s = file_dir.back();
@@ -447,20 +553,21 @@ void process_groups(string groups_filepath) {
     write_text_file(file_dir + ".." + s + ".." + s + "include" + s + "constants" + s + "map_groups.h", map_header_text);
 }
 
-string generate_layout_headers_text(Json layouts_data) {
+string generate_layout_headers_text(const JsonValue &layouts_data) {
     ostringstream text;
 
     text << "@\n@ DO NOT MODIFY THIS FILE! It is auto-generated from data/layouts/layouts.json\n@\n\n";
 
     for (auto &layout : layouts_data["layouts"].array_items()) {
-        string border_label = layout["name"].string_value() + "_Border";
-        string blockdata_label = layout["name"].string_value() + "_Blockdata";
+        JsonString name = layout["name"].string_value();
+        string border_label = name + "_Border";
+        string blockdata_label = name + "_Blockdata";
         text << border_label << "::\n"
              << "\t.incbin \"" << layout["border_filepath"].string_value() << "\"\n\n"
              << blockdata_label << "::\n"
              << "\t.incbin \"" << layout["blockdata_filepath"].string_value() << "\"\n\n"
              << "\t.align 2\n"
-             << layout["name"].string_value() << "::\n"
+             << name << "::\n"
              << "\t.4byte " << layout["width"].int_value() << "\n"
              << "\t.4byte " << layout["height"].int_value() << "\n"
              << "\t.4byte " << border_label << "\n"
@@ -472,7 +579,7 @@ string generate_layout_headers_text(Json layouts_data) {
     return text.str();
 }
 
-string generate_layouts_table_text(Json layouts_data) {
+string generate_layouts_table_text(const JsonValue &layouts_data) {
     ostringstream text;
 
     text << "@\n@ DO NOT MODIFY THIS FILE! It is auto-generated from data/layouts/layouts.json\n@\n\n";
@@ -486,7 +593,7 @@ string generate_layouts_table_text(Json layouts_data) {
     return text.str();
 }
 
-string generate_layouts_constants_text(Json layouts_data) {
+string generate_layouts_constants_text(const JsonValue &layouts_data) {
     ostringstream text;
 
     text << "#ifndef GUARD_CONSTANTS_LAYOUTS_H\n"
@@ -503,12 +610,9 @@ string generate_layouts_constants_text(Json layouts_data) {
     return text.str();
 }
 
-void process_layouts(string layouts_filepath) {
-    string err;
-    Json layouts_data = Json::parse(read_text_file(layouts_filepath), err);
-
-    if (layouts_data == Json())
-        FATAL_ERROR("%s\n", err.c_str());
+void process_layouts(const string &layouts_filepath) {
+    JsonDocument layouts_document = parse_json_file(layouts_filepath);
+    const JsonValue &layouts_data = layouts_document.root();
 
     string layout_headers_text = generate_layout_headers_text(layouts_data);
     string layouts_table_text = generate_layouts_table_text(layouts_data);
@@ -521,46 +625,3 @@ void process_layouts(string layouts_filepath) {
     write_text_file(file_dir + "layouts_table.inc", layouts_table_text);
     write_text_file(file_dir + ".." + s + ".." + s + "include" + s + "constants" + s + "layouts.h", layouts_constants_text);
 }
-
-int main(int argc, char *argv[]) {
-    if (argc < 3)
-        FATAL_ERROR("USAGE: mapjson <mode> <game-version> [options]\n");
-
-    char *version_arg = argv[2];
-    string version(version_arg);
-    if (version != "emerald" && version != "ruby")
-        FATAL_ERROR("ERROR: <game-version> must be 'emerald' or 'ruby'.\n");
-
-    char *mode_arg = argv[1];
-    string mode(mode_arg);
-    if (mode != "layouts" && mode != "map" && mode != "groups")
-        FATAL_ERROR("ERROR: <mode> must be 'layouts', 'map', or 'groups'.\n");
-
-    if (mode == "map") {
-        if (argc != 5)
-            FATAL_ERROR("USAGE: mapjson map <game-version> <map_file> <layouts_file>\n");
-
-        string filepath(argv[3]);
-        string layouts_filepath(argv[4]);
-
-        process_map(filepath, layouts_filepath, version);
-    }
-    else if (mode == "groups") {
-        if (argc != 4)
-            FATAL_ERROR("USAGE: mapjson groups <game-version> <groups_file>\n");
-
-        string filepath(argv[3]);
-
-        process_groups(filepath);
-    }
-    else if (mode == "layouts") {
-        if (argc != 4)
-            FATAL_ERROR("USAGE: mapjson layouts <game-version> <layouts_file>\n");
-
-        string filepath(argv[3]);
-
-        process_layouts(filepath);
-    }
-
-    return 0;
-}
@@ -28,4 +28,46 @@ do                                          \
 
 #endif // _MSC_VER
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "json.h"
+#include "map_cache.h"
+
+// Layouts by id, pointing into the layouts document. An id shared by more
+// than one layout maps to null, so it fails to match just like an id that
+// isn't there.
+typedef std::unordered_map<JsonString, const JsonValue *> LayoutIndex;
+
+struct MapTexts {
+    std::string header;
+    std::string events;
+    std::string connections;
+};
+
+extern int files_written;
+extern int files_unchanged;
+
+std::string read_text_file(const std::string &filepath);
+void write_text_file(const std::string &filepath, const std::string &text);
+JsonDocument parse_json_file(const std::string &filepath);
+
+LayoutIndex index_layouts(const JsonValue &layouts_data);
+MapTexts generate_map_texts(const JsonValue &map_data, const LayoutIndex &layouts, const std::string &version);
+void process_map(const std::string &map_filepath, const std::string &layouts_filepath, const std::string &version);
+void process_maps(const std::vector<std::string> &map_filepaths, const std::string &layouts_filepath, const std::string &version, int job_count, const std::string &cache_filepath);
+
+std::string generate_groups_text(const JsonValue &groups_data);
+std::string generate_connections_text(const JsonValue &groups_data);
+std::string generate_headers_text(const JsonValue &groups_data);
+std::string generate_events_text(const JsonValue &groups_data);
+std::string generate_map_constants_text(const std::string &groups_filepath, const JsonValue &groups_data, const MapCache &cache);
+void process_groups(const std::string &groups_filepath, const std::string &cache_filepath);
+
+std::string generate_layout_headers_text(const JsonValue &layouts_data);
+std::string generate_layouts_table_text(const JsonValue &layouts_data);
+std::string generate_layouts_constants_text(const JsonValue &layouts_data);
+void process_layouts(const std::string &layouts_filepath);
+
 #endif // MAPJSON_H
@@ -24,126 +24,111 @@
 #include <cstring>
 #include <vector>
 #include "agb.h"
-#include "main.h"
+#include "context.h"
 #include "midi.h"
 #include "tables.h"
 
-int g_agbTrack;
-
-static std::string s_lastOpName;
-static int s_blockNum;
-static bool s_keepLastOpName;
-static int s_lastNote;
-static int s_lastVelocity;
-static bool s_noteChanged;
-static bool s_velocityChanged;
-static bool s_inPattern;
-static int s_extendedCommand;
-static int s_memaccOp;
-static int s_memaccParam1;
-static int s_memaccParam2;
-
-void PrintAgbHeader()
+void PrintAgbHeader(Context& ctx)
 {
-    std::fprintf(g_outputFile, "\t.include \"MPlayDef.s\"\n\n");
-    std::fprintf(g_outputFile, "\t.equ\t%s_grp, voicegroup%03u\n", g_asmLabel.c_str(), g_voiceGroup);
-    std::fprintf(g_outputFile, "\t.equ\t%s_pri, %u\n", g_asmLabel.c_str(), g_priority);
+    AppendFormat(ctx, "\t.include \"MPlayDef.s\"\n\n");
+    AppendFormat(ctx, "\t.equ\t%s_grp, voicegroup%03u\n", ctx.asmLabel.c_str(), ctx.voiceGroup);
+    AppendFormat(ctx, "\t.equ\t%s_pri, %u\n", ctx.asmLabel.c_str(), ctx.priority);
 
-    if (g_reverb >= 0)
-        std::fprintf(g_outputFile, "\t.equ\t%s_rev, reverb_set+%u\n", g_asmLabel.c_str(), g_reverb);
+    if (ctx.reverb >= 0)
+        AppendFormat(ctx, "\t.equ\t%s_rev, reverb_set+%u\n", ctx.asmLabel.c_str(), ctx.reverb);
     else
-        std::fprintf(g_outputFile, "\t.equ\t%s_rev, 0\n", g_asmLabel.c_str());
+        AppendFormat(ctx, "\t.equ\t%s_rev, 0\n", ctx.asmLabel.c_str());
 
-    std::fprintf(g_outputFile, "\t.equ\t%s_mvl, %u\n", g_asmLabel.c_str(), g_masterVolume);
-    std::fprintf(g_outputFile, "\t.equ\t%s_key, %u\n", g_asmLabel.c_str(), 0);
-    std::fprintf(g_outputFile, "\t.equ\t%s_tbs, %u\n", g_asmLabel.c_str(), g_clocksPerBeat);
-    std::fprintf(g_outputFile, "\t.equ\t%s_exg, %u\n", g_asmLabel.c_str(), g_exactGateTime);
-    std::fprintf(g_outputFile, "\t.equ\t%s_cmp, %u\n", g_asmLabel.c_str(), g_compressionEnabled);
+    AppendFormat(ctx, "\t.equ\t%s_mvl, %u\n", ctx.asmLabel.c_str(), ctx.masterVolume);
+    AppendFormat(ctx, "\t.equ\t%s_key, %u\n", ctx.asmLabel.c_str(), 0);
+    AppendFormat(ctx, "\t.equ\t%s_tbs, %u\n", ctx.asmLabel.c_str(), ctx.clocksPerBeat);
+    AppendFormat(ctx, "\t.equ\t%s_exg, %u\n", ctx.asmLabel.c_str(), ctx.exactGateTime);
+    AppendFormat(ctx, "\t.equ\t%s_cmp, %u\n", ctx.asmLabel.c_str(), ctx.compressionEnabled);
 
-    std::fprintf(g_outputFile, "\n\t.section .rodata\n");
-    std::fprintf(g_outputFile, "\t.global\t%s\n", g_asmLabel.c_str());
+    AppendFormat(ctx, "\n\t.section .rodata\n");
+    AppendFormat(ctx, "\t.global\t%s\n", ctx.asmLabel.c_str());
 
-    std::fprintf(g_outputFile, "\t.align\t2\n");
+    AppendFormat(ctx, "\t.align\t2\n");
 }
 
-void ResetTrackVars()
+void ResetTrackVars(Context& ctx)
 {
-    s_lastVelocity = -1;
-    s_lastNote = -1;
-    s_velocityChanged = false;
-    s_noteChanged = false;
-    s_keepLastOpName = false;
-    s_lastOpName = "";
-    s_inPattern = false;
+    ctx.lastVelocity = -1;
+    ctx.lastNote = -1;
+    ctx.velocityChanged = false;
+    ctx.noteChanged = false;
+    ctx.keepLastOpName = false;
+    ctx.lastOpName = "";
+    ctx.inPattern = false;
 }
 
-void PrintWait(int wait)
+void PrintWait(Context& ctx, int wait)
 {
     if (wait > 0)
     {
-        std::fprintf(g_outputFile, "\t.byte\tW%02d\n", wait);
-        s_velocityChanged = true;
-        s_noteChanged = true;
-        s_keepLastOpName = true;
+        AppendFormat(ctx, "\t.byte\tW%02d\n", wait);
+        ctx.velocityChanged = true;
+        ctx.noteChanged = true;
+        ctx.keepLastOpName = true;
     }
 }
 
-void PrintOp(int wait, std::string name, const char *format, ...)
+void PrintOp(Context& ctx, int wait, std::string name, const char *format, ...)
 {
     std::va_list args;
     va_start(args, format);
-    std::fprintf(g_outputFile, "\t.byte\t\t");
+    ctx.output += "\t.byte\t\t";
 
     if (format != nullptr)
     {
-        if (!g_compressionEnabled || s_lastOpName != name)
+        if (!ctx.compressionEnabled || ctx.lastOpName != name)
         {
-            std::fprintf(g_outputFile, "%s, ", name.c_str());
-            s_lastOpName = name;
+            ctx.output += name + ", ";
+            ctx.lastOpName = name;
         }
         else
         {
-            std::fprintf(g_outputFile, "        ");
+            ctx.output += "        ";
         }
-        std::vfprintf(g_outputFile, format, args);
+        AppendFormatV(ctx, format, args);
     }
     else
     {
-        std::fputs(name.c_str(), g_outputFile);
-        s_lastOpName = name;
+        ctx.output += name;
+        ctx.lastOpName = name;
     }
 
-    std::fprintf(g_outputFile, "\n");
+    ctx.output += "\n";
 
     va_end(args);
 
-    PrintWait(wait);
+    PrintWait(ctx, wait);
 }
 
-void PrintByte(const char *format, ...)
+void PrintByte(Context& ctx, const char *format, ...)
 {
     std::va_list args;
     va_start(args, format);
-    std::fprintf(g_outputFile, "\t.byte\t");
-    std::vfprintf(g_outputFile, format, args);
-    std::fprintf(g_outputFile, "\n");
-    s_velocityChanged = true;
-    s_noteChanged = true;
-    s_keepLastOpName = true;
+    ctx.output += "\t.byte\t";
+    AppendFormatV(ctx, format, args);
+    ctx.output += "\n";
+    ctx.velocityChanged = true;
+    ctx.noteChanged = true;
+    ctx.keepLastOpName = true;
     va_end(args);
 }
 
-void PrintWord(const char *format, ...)
+void PrintWord(Context& ctx, const char *format, ...)
 {
     std::va_list args;
     va_start(args, format);
-    std::fprintf(g_outputFile, "\t .word\t");
-    std::vfprintf(g_outputFile, format, args);
-    std::fprintf(g_outputFile, "\n");
+    ctx.output += "\t .word\t";
+    AppendFormatV(ctx, format, args);
+    ctx.output += "\n";
     va_end(args);
 }
 
-void PrintNote(const Event& event)
+void PrintNote(Context& ctx, const Event& event)
 {
     int note = event.note;
     int velocity = g_noteVelocityLUT[event.param1];
@@ -154,7 +139,7 @@ void PrintNote(const Event& event)
 
     int gateTimeParam = 0;
 
-    if (g_exactGateTime && duration != -1)
+    if (ctx.exactGateTime && duration != -1)
         gateTimeParam = event.param2 - duration;
 
     char gtpBuf[16];
@@ -174,20 +159,20 @@ void PrintNote(const Event& event)
     bool noteChanged = true;
     bool velocityChanged = true;
 
-    if (g_compressionEnabled)
+    if (ctx.compressionEnabled)
     {
-        noteChanged = (note != s_lastNote);
-        velocityChanged = (velocity != s_lastVelocity);
+        noteChanged = (note != ctx.lastNote);
+        velocityChanged = (velocity != ctx.lastVelocity);
     }
 
-    if (s_keepLastOpName)
-        s_keepLastOpName = false;
+    if (ctx.keepLastOpName)
+        ctx.keepLastOpName = false;
     else
-        s_lastOpName = "";
+        ctx.lastOpName = "";
 
     if (noteChanged || velocityChanged || (gateTimeParam > 0))
     {
-        s_lastNote = note;
+        ctx.lastNote = note;
 
         char noteBuf[16];
 
@@ -200,7 +185,7 @@ void PrintNote(const Event& event)
 
         if (velocityChanged || (gateTimeParam > 0))
         {
-            s_lastVelocity = velocity;
+            ctx.lastVelocity = velocity;
             std::snprintf(velocityBuf, sizeof(velocityBuf), ", v%03u", velocity);
         }
         else
@@ -208,70 +193,70 @@ void PrintNote(const Event& event)
             velocityBuf[0] = 0;
         }
 
-        PrintOp(event.time, opName, "%s%s%s", noteBuf, velocityBuf, gtpBuf);
+        PrintOp(ctx, event.time, opName, "%s%s%s", noteBuf, velocityBuf, gtpBuf);
     }
     else
     {
-        PrintOp(event.time, opName, 0);
+        PrintOp(ctx, event.time, opName, 0);
     }
 
-    s_noteChanged = noteChanged;
-    s_velocityChanged = velocityChanged;
+    ctx.noteChanged = noteChanged;
+    ctx.velocityChanged = velocityChanged;
 }
 
-void PrintEndOfTieOp(const Event& event)
+void PrintEndOfTieOp(Context& ctx, const Event& event)
 {
     int note = event.note;
-    bool noteChanged = (note != s_lastNote);
+    bool noteChanged = (note != ctx.lastNote);
 
-    if (!noteChanged || !s_noteChanged)
-        s_lastOpName = "";
+    if (!noteChanged || !ctx.noteChanged)
+        ctx.lastOpName = "";
 
-    if (!noteChanged && g_compressionEnabled)
+    if (!noteChanged && ctx.compressionEnabled)
     {
-        PrintOp(event.time, "EOT   ", nullptr);
+        PrintOp(ctx, event.time, "EOT   ", nullptr);
     }
     else
     {
-        s_lastNote = note;
+        ctx.lastNote = note;
         if (note >= 24)
-            PrintOp(event.time, "EOT   ", g_noteTable[note % 12], note / 12 - 2);
+            PrintOp(ctx, event.time, "EOT   ", g_noteTable[note % 12], note / 12 - 2);
         else
-            PrintOp(event.time, "EOT   ", g_minusNoteTable[note % 12], note / -12 + 2);
+            PrintOp(ctx, event.time, "EOT   ", g_minusNoteTable[note % 12], note / -12 + 2);
     }
 
-    s_noteChanged = noteChanged;
+    ctx.noteChanged = noteChanged;
 }
 
-void PrintSeqLoopLabel(const Event& event)
+void PrintSeqLoopLabel(Context& ctx, const Event& event)
 {
-    s_blockNum = event.param1 + 1;
-    std::fprintf(g_outputFile, "%s_%u_B%u:\n", g_asmLabel.c_str(), g_agbTrack, s_blockNum);
-    PrintWait(event.time);
-    ResetTrackVars();
+    ctx.blockNum = event.param1 + 1;
+    AppendFormat(ctx, "%s_%u_B%u:\n", ctx.asmLabel.c_str(), ctx.agbTrack, ctx.blockNum);
+    PrintWait(ctx, event.time);
+    ResetTrackVars(ctx);
 }
 
-void PrintMemAcc(const Event& event)
+void PrintMemAcc(Context& ctx, const Event& event)
 {
-    switch (s_memaccOp)
+    switch (ctx.memaccOp)
     {
     case 0x00:
-        PrintByte("MEMACC, mem_set, 0x%02X, %u", s_memaccParam1, event.param2);
+        PrintByte(ctx, "MEMACC, mem_set, 0x%02X, %u", ctx.memaccParam1, event.param2);
         break;
     case 0x01:
-        PrintByte("MEMACC, mem_add, 0x%02X, %u", s_memaccParam1, event.param2);
+        PrintByte(ctx, "MEMACC, mem_add, 0x%02X, %u", ctx.memaccParam1, event.param2);
         break;
     case 0x02:
-        PrintByte("MEMACC, mem_sub, 0x%02X, %u", s_memaccParam1, event.param2);
+        PrintByte(ctx, "MEMACC, mem_sub, 0x%02X, %u", ctx.memaccParam1, event.param2);
         break;
     case 0x03:
-        PrintByte("MEMACC, mem_mem_set, 0x%02X, 0x%02X", s_memaccParam1, event.param2);
+        PrintByte(ctx, "MEMACC, mem_mem_set, 0x%02X, 0x%02X", ctx.memaccParam1, event.param2);
         break;
     case 0x04:
-        PrintByte("MEMACC, mem_mem_add, 0x%02X, 0x%02X", s_memaccParam1, event.param2);
+        PrintByte(ctx, "MEMACC, mem_mem_add, 0x%02X, 0x%02X", ctx.memaccParam1, event.param2);
         break;
     case 0x05:
-        PrintByte("MEMACC, mem_mem_sub, 0x%02X, 0x%02X", s_memaccParam1, event.param2);
+        PrintByte(ctx, "MEMACC, mem_mem_sub, 0x%02X, 0x%02X", ctx.memaccParam1, event.param2);
         break;
     // TODO: everything else
     case 0x06:
@@ -326,104 +311,104 @@ void PrintMemAcc(const Event& event)
         break;
     }
 
-    PrintWait(event.time);
+    PrintWait(ctx, event.time);
 }
 
-void PrintExtendedOp(const Event& event)
+void PrintExtendedOp(Context& ctx, const Event& event)
 {
     // TODO: support for other extended commands
 
-    switch (s_extendedCommand)
+    switch (ctx.extendedCommand)
     {
     case 0x08:
-        PrintOp(event.time, "XCMD  ", "xIECV , %u", event.param2);
+        PrintOp(ctx, event.time, "XCMD  ", "xIECV , %u", event.param2);
         break;
     case 0x09:
-        PrintOp(event.time, "XCMD  ", "xIECL , %u", event.param2);
+        PrintOp(ctx, event.time, "XCMD  ", "xIECL , %u", event.param2);
         break;
     default:
-        PrintWait(event.time);
+        PrintWait(ctx, event.time);
         break;
     }
 }
 
-void PrintControllerOp(const Event& event)
+void PrintControllerOp(Context& ctx, const Event& event)
 {
     switch (event.param1)
     {
     case 0x01:
-        PrintOp(event.time, "MOD   ", "%u", event.param2);
+        PrintOp(ctx, event.time, "MOD   ", "%u", event.param2);
         break;
     case 0x07:
-        PrintOp(event.time, "VOL   ", "%u*%s_mvl/mxv", event.param2, g_asmLabel.c_str());
+        PrintOp(ctx, event.time, "VOL   ", "%u*%s_mvl/mxv", event.param2, ctx.asmLabel.c_str());
         break;
     case 0x0A:
-        PrintOp(event.time, "PAN   ", "c_v%+d", event.param2 - 64);
+        PrintOp(ctx, event.time, "PAN   ", "c_v%+d", event.param2 - 64);
         break;
     case 0x0C:
     case 0x10:
-        PrintMemAcc(event);
+        PrintMemAcc(ctx, event);
         break;
     case 0x0D:
-        s_memaccOp = event.param2;
-        PrintWait(event.time);
+        ctx.memaccOp = event.param2;
+        PrintWait(ctx, event.time);
         break;
     case 0x0E:
-        s_memaccParam1 = event.param2;
-        PrintWait(event.time);
+        ctx.memaccParam1 = event.param2;
+        PrintWait(ctx, event.time);
         break;
     case 0x0F:
-        s_memaccParam2 = event.param2;
-        PrintWait(event.time);
+        ctx.memaccParam2 = event.param2;
+        PrintWait(ctx, event.time);
         break;
     case 0x11:
-        std::fprintf(g_outputFile, "%s_%u_L%u:\n", g_asmLabel.c_str(), g_agbTrack, event.param2);
-        PrintWait(event.time);
-        ResetTrackVars();
+        AppendFormat(ctx, "%s_%u_L%u:\n", ctx.asmLabel.c_str(), ctx.agbTrack, event.param2);
+        PrintWait(ctx, event.time);
+        ResetTrackVars(ctx);
         break;
     case 0x14:
-        PrintOp(event.time, "BENDR ", "%u", event.param2);
+        PrintOp(ctx, event.time, "BENDR ", "%u", event.param2);
         break;
     case 0x15:
-        PrintOp(event.time, "LFOS  ", "%u", event.param2);
+        PrintOp(ctx, event.time, "LFOS  ", "%u", event.param2);
         break;
     case 0x16:
-        PrintOp(event.time, "MODT  ", "%u", event.param2);
+        PrintOp(ctx, event.time, "MODT  ", "%u", event.param2);
         break;
     case 0x18:
-        PrintOp(event.time, "TUNE  ", "c_v%+d", event.param2 - 64);
+        PrintOp(ctx, event.time, "TUNE  ", "c_v%+d", event.param2 - 64);
         break;
     case 0x1A:
-        PrintOp(event.time, "LFODL ", "%u", event.param2);
+        PrintOp(ctx, event.time, "LFODL ", "%u", event.param2);
         break;
     case 0x1D:
     case 0x1F:
-        PrintExtendedOp(event);
+        PrintExtendedOp(ctx, event);
         break;
     case 0x1E:
-        s_extendedCommand = event.param2;
+        ctx.extendedCommand = event.param2;
         // TODO: loop op
         break;
     case 0x21:
     case 0x27:
-        PrintByte("PRIO  , %u", event.param2);
-        PrintWait(event.time);
+        PrintByte(ctx, "PRIO  , %u", event.param2);
+        PrintWait(ctx, event.time);
         break;
     default:
-        PrintWait(event.time);
+        PrintWait(ctx, event.time);
         break;
     }
 }
 
-void PrintAgbTrack(std::vector<Event>& events)
+void PrintAgbTrack(Context& ctx, std::vector<Event>& events)
 {
-    std::fprintf(g_outputFile, "\n@**************** Track %u (Midi-Chn.%u) ****************@\n\n", g_agbTrack, g_midiChan + 1);
-    std::fprintf(g_outputFile, "%s_%u:\n", g_asmLabel.c_str(), g_agbTrack);
+    AppendFormat(ctx, "\n@**************** Track %u (Midi-Chn.%u) ****************@\n\n", ctx.agbTrack, ctx.midiChan + 1);
+    AppendFormat(ctx, "%s_%u:\n", ctx.asmLabel.c_str(), ctx.agbTrack);
 
     int wholeNoteCount = 0;
     int loopEndBlockNum = 0;
 
-    ResetTrackVars();
+    ResetTrackVars(ctx);
 
     bool foundVolBeforeNote = false;
 
@@ -440,10 +425,10 @@ void PrintAgbTrack(std::vector<Event>& events)
     }
 
     if (!foundVolBeforeNote)
-        PrintByte("\tVOL   , 127*%s_mvl/mxv", g_asmLabel.c_str());
+        PrintByte(ctx, "\tVOL   , 127*%s_mvl/mxv", ctx.asmLabel.c_str());
 
-    PrintWait(g_initialWait);
-    PrintByte("KEYSH , %s_key%+d", g_asmLabel.c_str(), 0);
+    PrintWait(ctx, ctx.initialWait);
+    PrintByte(ctx, "KEYSH , %s_key%+d", ctx.asmLabel.c_str(), 0);
 
     for (unsigned i = 0; events[i].type != EventType::EndOfTrack; i++)
     {
@@ -451,98 +436,98 @@ void PrintAgbTrack(std::vector<Event>& events)
 
         if (IsPatternBoundary(event.type))
         {
-            if (s_inPattern)
-                PrintByte("PEND");
-            s_inPattern = false;
+            if (ctx.inPattern)
+                PrintByte(ctx, "PEND");
+            ctx.inPattern = false;
         }
 
         if (event.type == EventType::WholeNoteMark || event.type == EventType::Pattern)
-            std::fprintf(g_outputFile, "@ %03d   ----------------------------------------\n", wholeNoteCount++);
+            AppendFormat(ctx, "@ %03d   ----------------------------------------\n", wholeNoteCount++);
 
         switch (event.type)
         {
         case EventType::Note:
-            PrintNote(event);
+            PrintNote(ctx, event);
             break;
         case EventType::EndOfTie:
-            PrintEndOfTieOp(event);
+            PrintEndOfTieOp(ctx, event);
             break;
         case EventType::Label:
-            PrintSeqLoopLabel(event);
+            PrintSeqLoopLabel(ctx, event);
             break;
         case EventType::LoopEnd:
-            PrintByte("GOTO");
-            PrintWord("%s_%u_B%u", g_asmLabel.c_str(), g_agbTrack, loopEndBlockNum);
-            PrintSeqLoopLabel(event);
+            PrintByte(ctx, "GOTO");
+            PrintWord(ctx, "%s_%u_B%u", ctx.asmLabel.c_str(), ctx.agbTrack, loopEndBlockNum);
+            PrintSeqLoopLabel(ctx, event);
             break;
         case EventType::LoopEndBegin:
-            PrintByte("GOTO");
-            PrintWord("%s_%u_B%u", g_asmLabel.c_str(), g_agbTrack, loopEndBlockNum);
-            PrintSeqLoopLabel(event);
-            loopEndBlockNum = s_blockNum;
+            PrintByte(ctx, "GOTO");
+            PrintWord(ctx, "%s_%u_B%u", ctx.asmLabel.c_str(), ctx.agbTrack, loopEndBlockNum);
+            PrintSeqLoopLabel(ctx, event);
+            loopEndBlockNum = ctx.blockNum;
             break;
         case EventType::LoopBegin:
-            PrintSeqLoopLabel(event);
-            loopEndBlockNum = s_blockNum;
+            PrintSeqLoopLabel(ctx, event);
+            loopEndBlockNum = ctx.blockNum;
             break;
         case EventType::WholeNoteMark:
             if (event.param2 & 0x80000000)
             {
-                std::fprintf(g_outputFile, "%s_%u_%03lu:\n", g_asmLabel.c_str(), g_agbTrack, (unsigned long)(event.param2 & 0x7FFFFFFF));
-                ResetTrackVars();
-                s_inPattern = true;
+                AppendFormat(ctx, "%s_%u_%03lu:\n", ctx.asmLabel.c_str(), ctx.agbTrack, (unsigned long)(event.param2 & 0x7FFFFFFF));
+                ResetTrackVars(ctx);
+                ctx.inPattern = true;
             }
-            PrintWait(event.time);
+            PrintWait(ctx, event.time);
             break;
         case EventType::Pattern:
-            PrintByte("PATT");
-            PrintWord("%s_%u_%03lu", g_asmLabel.c_str(), g_agbTrack, event.param2);
+            PrintByte(ctx, "PATT");
+            PrintWord(ctx, "%s_%u_%03lu", ctx.asmLabel.c_str(), ctx.agbTrack, event.param2);
 
             while (!IsPatternBoundary(events[i + 1].type))
                 i++;
 
-            ResetTrackVars();
+            ResetTrackVars(ctx);
             break;
         case EventType::Tempo:
-            PrintByte("TEMPO , %u*%s_tbs/2", static_cast<int>(round(60000000.0f / static_cast<float>(event.param2))), g_asmLabel.c_str());
-            PrintWait(event.time);
+            PrintByte(ctx, "TEMPO , %u*%s_tbs/2", static_cast<int>(round(60000000.0f / static_cast<float>(event.param2))), ctx.asmLabel.c_str());
+            PrintWait(ctx, event.time);
             break;
         case EventType::InstrumentChange:
-            PrintOp(event.time, "VOICE ", "%u", event.param1);
+            PrintOp(ctx, event.time, "VOICE ", "%u", event.param1);
             break;
         case EventType::PitchBend:
-            PrintOp(event.time, "BEND  ", "c_v%+d", event.param2 - 64);
+            PrintOp(ctx, event.time, "BEND  ", "c_v%+d", event.param2 - 64);
             break;
         case EventType::Controller:
-            PrintControllerOp(event);
+            PrintControllerOp(ctx, event);
             break;
         default:
-            PrintWait(event.time);
+            PrintWait(ctx, event.time);
             break;
         }
     }
 
-    PrintByte("FINE");
+    PrintByte(ctx, "FINE");
 }
 
-void PrintAgbFooter()
+void PrintAgbFooter(Context& ctx)
 {
-    int trackCount = g_agbTrack - 1;
-
-    std::fprintf(g_outputFile, "\n@******************************************************@\n");
-    std::fprintf(g_outputFile, "\t.align\t2\n");
-    std::fprintf(g_outputFile, "\n%s:\n", g_asmLabel.c_str());
-    std::fprintf(g_outputFile, "\t.byte\t%u\t@ NumTrks\n", trackCount);
-    std::fprintf(g_outputFile, "\t.byte\t%u\t@ NumBlks\n", 0);
-    std::fprintf(g_outputFile, "\t.byte\t%s_pri\t@ Priority\n", g_asmLabel.c_str());
-    std::fprintf(g_outputFile, "\t.byte\t%s_rev\t@ Reverb.\n", g_asmLabel.c_str());
-    std::fprintf(g_outputFile, "\n");
-    std::fprintf(g_outputFile, "\t.word\t%s_grp\n", g_asmLabel.c_str());
-    std::fprintf(g_outputFile, "\n");
+    int trackCount = ctx.agbTrack - 1;
+
+    AppendFormat(ctx, "\n@******************************************************@\n");
+    AppendFormat(ctx, "\t.align\t2\n");
+    AppendFormat(ctx, "\n%s:\n", ctx.asmLabel.c_str());
+    AppendFormat(ctx, "\t.byte\t%u\t@ NumTrks\n", trackCount);
+    AppendFormat(ctx, "\t.byte\t%u\t@ NumBlks\n", 0);
+    AppendFormat(ctx, "\t.byte\t%s_pri\t@ Priority\n", ctx.asmLabel.c_str());
+    AppendFormat(ctx, "\t.byte\t%s_rev\t@ Reverb.\n", ctx.asmLabel.c_str());
+    ctx.output += "\n";
+    AppendFormat(ctx, "\t.word\t%s_grp\n", ctx.asmLabel.c_str());
+    ctx.output += "\n";
 
     // track pointers
     for (int i = 1; i <= trackCount; i++)
-        std::fprintf(g_outputFile, "\t.word\t%s_%u\n", g_asmLabel.c_str(), i);
+        AppendFormat(ctx, "\t.word\t%s_%u\n", ctx.asmLabel.c_str(), i);
 
-    std::fprintf(g_outputFile, "\n\t.end\n");
+    AppendFormat(ctx, "\n\t.end\n");
 }
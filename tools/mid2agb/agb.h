@@ -24,10 +24,8 @@
 #include <vector>
 #include "midi.h"
 
-void PrintAgbHeader();
-void PrintAgbTrack(std::vector<Event>& events);
-void PrintAgbFooter();
-
-extern int g_agbTrack;
+void PrintAgbHeader(Context& ctx);
+void PrintAgbTrack(Context& ctx, std::vector<Event>& events);
+void PrintAgbFooter(Context& ctx);
 
 #endif // AGB_H
@@ -0,0 +1,187 @@
+#include <cstdio>
+#include <cstdarg>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "context.h"
+#include "error.h"
+
+// The assembly typically comes out at 4 to 8 times the size of the MIDI
+// file, so reserve enough up front to avoid most regrowth.
+static void ReserveOutput(Context& ctx)
+{
+    ctx.output.reserve(ctx.inputSize * 8);
+}
+
+#ifdef _WIN32
+
+#include <memory>
+
+void MapInputFile(Context& ctx, const std::string& path)
+{
+    // Owned until the end, so that an error part way through leaks neither.
+    std::unique_ptr<FILE, int (*)(FILE *)> fp(std::fopen(path.c_str(), "rb"), std::fclose);
+
+    if (fp == nullptr)
+        RaiseError("failed to open \"%s\" for reading", path.c_str());
+
+    std::fseek(fp.get(), 0, SEEK_END);
+    long size = std::ftell(fp.get());
+    std::rewind(fp.get());
+
+    if (size < 0)
+        RaiseError("failed to get size of \"%s\"", path.c_str());
+
+    std::unique_ptr<std::uint8_t[]> buffer(new std::uint8_t[size > 0 ? size : 1]);
+
+    if (size > 0 && std::fread(buffer.get(), size, 1, fp.get()) != 1)
+        RaiseError("failed to read \"%s\"", path.c_str());
+
+    UnmapInputFile(ctx);
+    ctx.input = buffer.get();
+    ctx.inputSize = size;
+    ctx.inputPos = 0;
+    ctx.mapping = buffer.release();
+    ctx.mappingSize = size;
+    ReserveOutput(ctx);
+}
+
+void UnmapInputFile(Context& ctx)
+{
+    delete[] static_cast<std::uint8_t *>(ctx.mapping);
+    ctx.mapping = nullptr;
+    ctx.mappingSize = 0;
+    ctx.input = nullptr;
+    ctx.inputSize = 0;
+}
+
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Closes a file descriptor on the way out, including when an error is raised.
+class FileDescriptor
+{
+public:
+    explicit FileDescriptor(int fd) : m_fd(fd) {}
+    ~FileDescriptor()
+    {
+        if (m_fd >= 0)
+            close(m_fd);
+    }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    int Get() const { return m_fd; }
+
+private:
+    int m_fd;
+};
+
+void MapInputFile(Context& ctx, const std::string& path)
+{
+    FileDescriptor fd(open(path.c_str(), O_RDONLY));
+
+    if (fd.Get() < 0)
+        RaiseError("failed to open \"%s\" for reading", path.c_str());
+
+    struct stat st;
+
+    if (fstat(fd.Get(), &st) != 0)
+        RaiseError("failed to get size of \"%s\"", path.c_str());
+
+    void *mapping = nullptr;
+
+    // mmap refuses zero-length mappings; an empty file just has no input.
+    if (st.st_size > 0)
+    {
+        mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd.Get(), 0);
+
+        if (mapping == MAP_FAILED)
+            RaiseError("failed to map \"%s\"", path.c_str());
+    }
+
+    // From here the context owns the mapping, and unmaps it when it is
+    // destroyed even if the conversion fails.
+    UnmapInputFile(ctx);
+    ctx.input = static_cast<const std::uint8_t *>(mapping);
+    ctx.inputSize = st.st_size;
+    ctx.inputPos = 0;
+    ctx.mapping = mapping;
+    ctx.mappingSize = st.st_size;
+    ReserveOutput(ctx);
+}
+
+void UnmapInputFile(Context& ctx)
+{
+    if (ctx.mapping != nullptr)
+        munmap(ctx.mapping, ctx.mappingSize);
+
+    ctx.mapping = nullptr;
+    ctx.mappingSize = 0;
+    ctx.input = nullptr;
+    ctx.inputSize = 0;
+}
+
+#endif
+
+Context::~Context()
+{
+    UnmapInputFile(*this);
+}
+
+void WriteOutputFile(const Context& ctx, const std::string& path)
+{
+    FILE *fp = std::fopen(path.c_str(), "w");
+
+    if (fp == nullptr)
+        RaiseError("failed to open \"%s\" for writing", path.c_str());
+
+    if (!ctx.output.empty() && std::fwrite(ctx.output.data(), ctx.output.size(), 1, fp) != 1)
+        RaiseError("failed to write \"%s\"", path.c_str());
+
+    if (std::fclose(fp) != 0)
+        RaiseError("failed to write \"%s\"", path.c_str());
+}
+
+void AppendFormatV(Context& ctx, const char *format, std::va_list args)
+{
+    // Formatting has a fixed cost per call, so plain text is copied as is.
+    if (std::strchr(format, '%') == nullptr)
+    {
+        ctx.output += format;
+        return;
+    }
+
+    char buffer[256];
+    std::va_list argsCopy;
+    va_copy(argsCopy, args);
+    int length = std::vsnprintf(buffer, sizeof(buffer), format, argsCopy);
+    va_end(argsCopy);
+
+    if (length < 0)
+        RaiseError("failed to format output");
+
+    if ((std::size_t)length < sizeof(buffer))
+    {
+        ctx.output.append(buffer, length);
+    }
+    else
+    {
+        std::vector<char> bigBuffer(length + 1);
+        std::vsnprintf(bigBuffer.data(), bigBuffer.size(), format, args);
+        ctx.output.append(bigBuffer.data(), length);
+    }
+}
+
+void AppendFormat(Context& ctx, const char *format, ...)
+{
+    std::va_list args;
+    va_start(args, format);
+    AppendFormatV(ctx, format, args);
+    va_end(args);
+}
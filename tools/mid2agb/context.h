@@ -0,0 +1,92 @@
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "midi.h"
+#include "report.h"
+
+// Everything a single MIDI to AGB conversion works on: its options, the
+// mapped MIDI file, the assembly being built and the state of the reader
+// and printer. Conversions with separate contexts can run concurrently.
+struct Context
+{
+    Context() = default;
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+    ~Context();
+
+    // options
+    std::string asmLabel;
+    int masterVolume = 127;
+    int voiceGroup = 0;
+    int priority = 0;
+    int reverb = -1;
+    int clocksPerBeat = 1;
+    bool exactGateTime = false;
+    bool compressionEnabled = true;
+    std::string reportFilename;
+
+    // The MIDI file is mapped into memory and parsed in place, and the
+    // assembly is accumulated in a buffer that is written out at the end.
+    const std::uint8_t *input = nullptr;
+    std::size_t inputSize = 0;
+    std::size_t inputPos = 0;
+    std::string output;
+
+    // Set when input points to a mapping rather than to caller memory.
+    void *mapping = nullptr;
+    std::size_t mappingSize = 0;
+
+    // MIDI reader
+    MidiFormat midiFormat = MidiFormat::SingleTrack;
+    std::int_fast32_t midiTrackCount = 0;
+    std::int16_t midiTimeDiv = 0;
+    int midiChan = 0;
+    std::int32_t initialWait = 0;
+    long trackDataStart = 0;
+    std::vector<Event> seqEvents;
+    std::vector<Event> trackEvents;
+    std::vector<Event> channelEvents[16];
+    std::int32_t absoluteTime = 0;
+    int blockCount = 0;
+    int minNote[16] = {};
+    int maxNote[16] = {};
+    int runningStatus = 0;
+    std::vector<ChannelMessage> channelMessages;
+    std::int32_t endOfTrackTime = 0;
+
+    // Indices into channelEvents of the notes still waiting for their
+    // note off, by channel and key.
+    std::vector<unsigned> pendingNotes[16][128];
+
+    // AGB printer
+    int agbTrack = 0;
+    std::string lastOpName;
+    int blockNum = 0;
+    bool keepLastOpName = false;
+    int lastNote = 0;
+    int lastVelocity = 0;
+    bool noteChanged = false;
+    bool velocityChanged = false;
+    bool inPattern = false;
+    int extendedCommand = 0;
+    int memaccOp = 0;
+    int memaccParam1 = 0;
+    int memaccParam2 = 0;
+
+    // Only gathered when reportFilename is set.
+    SongReport report;
+};
+
+void MapInputFile(Context& ctx, const std::string& path);
+void UnmapInputFile(Context& ctx);
+void WriteOutputFile(const Context& ctx, const std::string& path);
+
+void AppendFormat(Context& ctx, const char *format, ...);
+void AppendFormatV(Context& ctx, const char *format, std::va_list args);
+
+#endif // CONTEXT_H
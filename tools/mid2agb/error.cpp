@@ -21,8 +21,10 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstdarg>
+#include <stdexcept>
 
-// Reports an error diagnostic and terminates the program.
+// Throws an error diagnostic. It is reported by main, or against the
+// failing song in batch mode.
 [[noreturn]] void RaiseError(const char* format, ...)
 {
     const int bufferSize = 1024;
@@ -30,7 +32,6 @@
     std::va_list args;
     va_start(args, format);
     std::vsnprintf(buffer, bufferSize, format, args);
-    std::fprintf(stderr, "error: %s\n", buffer);
     va_end(args);
-    std::exit(1);
+    throw std::runtime_error(buffer);
 }
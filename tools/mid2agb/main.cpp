@@ -25,27 +25,23 @@
 #include <cassert>
 #include <string>
 #include <set>
-#include "main.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <exception>
+#include "context.h"
 #include "error.h"
 #include "midi.h"
 #include "agb.h"
 
-FILE* g_inputFile = nullptr;
-FILE* g_outputFile = nullptr;
-
-std::string g_asmLabel;
-int g_masterVolume = 127;
-int g_voiceGroup = 0;
-int g_priority = 0;
-int g_reverb = -1;
-int g_clocksPerBeat = 1;
-bool g_exactGateTime = false;
-bool g_compressionEnabled = true;
-
 [[noreturn]] static void PrintUsage()
 {
     std::printf(
         "Usage: MID2AGB name [options]\n"
+        "       MID2AGB -M manifest [-J jobs]\n"
         "\n"
         "    input_file  filename(.mid) of MIDI file\n"
         "   output_file  filename(.s) for AGB file (default:input_file)\n"
@@ -58,6 +54,11 @@ bool g_compressionEnabled = true;
         "            -X  48 clocks/beat (default:24 clocks/beat)\n"
         "            -E  exact gate-time\n"
         "            -N  no compression\n"
+        "   --report ???  write playback statistics for the song as JSON\n"
+        "\n"
+        "batch    -M???  convert the songs listed in a manifest file, one\n"
+        "                \"input_file output_file [options]\" per line\n"
+        "         -J???  songs converted at once (default:number of CPUs)\n"
     );
     std::exit(1);
 }
@@ -127,62 +128,93 @@ static const char *GetArgument(int argc, char **argv, int& index)
     }
 }
 
-int main(int argc, char** argv)
+struct BatchOptions
+{
+    std::string manifestFilename;
+    int jobCount = 0;
+    // Set if any song option was given, which -M doesn't allow.
+    bool hasSongOptions = false;
+};
+
+// Reads the file names and options of a single song into ctx, or the batch
+// options if batch is non-null. Returns false if the arguments are invalid.
+static bool ParseArguments(int argc, char **argv, Context& ctx, std::string& inputFilename, std::string& outputFilename, BatchOptions *batch)
 {
-    std::string inputFilename;
-    std::string outputFilename;
-
     for (int i = 1; i < argc; i++)
     {
         const char *option = argv[i];
 
-        if (option[0] == '-' && option[1] != '\0')
+        if (std::strcmp(option, "--report") == 0)
+        {
+            if (i + 1 >= argc)
+                return false;
+            ctx.reportFilename = argv[++i];
+            if (batch != nullptr)
+                batch->hasSongOptions = true;
+        }
+        else if (option[0] == '-' && option[1] != '\0')
         {
             const char *arg;
+            int letter = std::toupper(option[1]);
+
+            if (batch != nullptr && letter != 'J' && letter != 'M')
+                batch->hasSongOptions = true;
 
-            switch (std::toupper(option[1]))
+            switch (letter)
             {
             case 'E':
-                g_exactGateTime = true;
+                ctx.exactGateTime = true;
                 break;
             case 'G':
                 arg = GetArgument(argc, argv, i);
                 if (arg == nullptr)
-                    PrintUsage();
-                g_voiceGroup = std::stoi(arg);
+                    return false;
+                ctx.voiceGroup = std::stoi(arg);
+                break;
+            case 'J':
+                arg = GetArgument(argc, argv, i);
+                if (arg == nullptr || batch == nullptr)
+                    return false;
+                batch->jobCount = std::stoi(arg);
                 break;
             case 'L':
                 arg = GetArgument(argc, argv, i);
                 if (arg == nullptr)
-                    PrintUsage();
-                g_asmLabel = arg;
+                    return false;
+                ctx.asmLabel = arg;
+                break;
+            case 'M':
+                arg = GetArgument(argc, argv, i);
+                if (arg == nullptr || batch == nullptr)
+                    return false;
+                batch->manifestFilename = arg;
                 break;
             case 'N':
-                g_compressionEnabled = false;
+                ctx.compressionEnabled = false;
                 break;
             case 'P':
                 arg = GetArgument(argc, argv, i);
                 if (arg == nullptr)
-                    PrintUsage();
-                g_priority = std::stoi(arg);
+                    return false;
+                ctx.priority = std::stoi(arg);
                 break;
             case 'R':
                 arg = GetArgument(argc, argv, i);
                 if (arg == nullptr)
-                    PrintUsage();
-                g_reverb = std::stoi(arg);
+                    return false;
+                ctx.reverb = std::stoi(arg);
                 break;
             case 'V':
                 arg = GetArgument(argc, argv, i);
                 if (arg == nullptr)
-                    PrintUsage();
-                g_masterVolume = std::stoi(arg);
+                    return false;
+                ctx.masterVolume = std::stoi(arg);
                 break;
             case 'X':
-                g_clocksPerBeat = 2;
+                ctx.clocksPerBeat = 2;
                 break;
             default:
-                PrintUsage();
+                return false;
             }
         }
         else
@@ -192,13 +224,15 @@ int main(int argc, char** argv)
             else if (outputFilename.empty())
                 outputFilename = argv[i];
             else
-                PrintUsage();
+                return false;
         }
     }
 
-    if (inputFilename.empty())
-        PrintUsage();
+    return true;
+}
 
+static void ConvertSong(Context& ctx, const std::string& inputFilename, std::string outputFilename)
+{
     if (GetExtension(inputFilename) != "mid")
         RaiseError("input filename extension is not \"mid\"");
 
@@ -208,26 +242,169 @@ int main(int argc, char** argv)
     if (GetExtension(outputFilename) != "s")
         RaiseError("output filename extension is not \"s\"");
 
-    if (g_asmLabel.empty())
-        g_asmLabel = BaseName(outputFilename);
+    if (ctx.asmLabel.empty())
+        ctx.asmLabel = BaseName(outputFilename);
 
-    g_inputFile = std::fopen(inputFilename.c_str(), "rb");
+    MapInputFile(ctx, inputFilename);
 
-    if (g_inputFile == nullptr)
-        RaiseError("failed to open \"%s\" for reading", inputFilename.c_str());
+    ReadMidiFileHeader(ctx);
+    PrintAgbHeader(ctx);
+    ReadMidiTracks(ctx);
+    PrintAgbFooter(ctx);
 
-    g_outputFile = std::fopen(outputFilename.c_str(), "w");
+    UnmapInputFile(ctx);
+    WriteOutputFile(ctx, outputFilename);
 
-    if (g_outputFile == nullptr)
-        RaiseError("failed to open \"%s\" for writing", outputFilename.c_str());
+    if (!ctx.reportFilename.empty())
+        WriteReport(ctx, inputFilename, ctx.reportFilename);
+}
 
-    ReadMidiFileHeader();
-    PrintAgbHeader();
-    ReadMidiTracks();
-    PrintAgbFooter();
+struct Song
+{
+    int lineNum;
+    std::vector<std::string> args;
+};
+
+// Converts the song described by one manifest line with a fresh context.
+static void ConvertManifestSong(const Song& song)
+{
+    std::vector<char *> argv;
 
-    std::fclose(g_inputFile);
-    std::fclose(g_outputFile);
+    argv.push_back(nullptr);
+
+    for (const std::string& arg : song.args)
+        argv.push_back(const_cast<char *>(arg.c_str()));
+
+    std::unique_ptr<Context> ctx(new Context());
+    std::string inputFilename;
+    std::string outputFilename;
+
+    if (!ParseArguments(argv.size(), argv.data(), *ctx, inputFilename, outputFilename, nullptr) || inputFilename.empty())
+        RaiseError("invalid arguments");
+
+    ConvertSong(*ctx, inputFilename, outputFilename);
+}
+
+static std::vector<Song> ReadManifest(const std::string& manifestFilename)
+{
+    std::ifstream file(manifestFilename);
+
+    if (!file.is_open())
+        RaiseError("failed to open \"%s\" for reading", manifestFilename.c_str());
+
+    std::vector<Song> songs;
+    std::string line;
+    int lineNum = 0;
+
+    while (std::getline(file, line))
+    {
+        lineNum++;
+
+        Song song;
+        song.lineNum = lineNum;
+
+        std::istringstream tokens(line);
+        std::string token;
+
+        while (tokens >> token && token[0] != '#')
+            song.args.push_back(token);
+
+        if (!song.args.empty())
+            songs.push_back(song);
+    }
+
+    return songs;
+}
+
+// Converts every song in the manifest, spreading them over jobCount threads.
+// A song that fails doesn't stop the others; all errors are reported at the end.
+static int ConvertManifest(const BatchOptions& batch)
+{
+    std::vector<Song> songs = ReadManifest(batch.manifestFilename);
+    std::vector<std::string> errors(songs.size());
+    std::atomic<std::size_t> nextSong(0);
+
+    auto worker = [&]()
+    {
+        for (std::size_t i = nextSong++; i < songs.size(); i = nextSong++)
+        {
+            try
+            {
+                ConvertManifestSong(songs[i]);
+            }
+            catch (const std::exception& e)
+            {
+                errors[i] = e.what();
+            }
+        }
+    };
+
+    int jobCount = batch.jobCount;
+
+    if (jobCount <= 0)
+        jobCount = std::thread::hardware_concurrency();
+
+    if (jobCount <= 0)
+        jobCount = 1;
+
+    if ((std::size_t)jobCount > songs.size())
+        jobCount = songs.size();
+
+    std::vector<std::thread> threads;
+
+    for (int i = 1; i < jobCount; i++)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    int result = 0;
+
+    for (std::size_t i = 0; i < songs.size(); i++)
+    {
+        if (!errors[i].empty())
+        {
+            std::fprintf(stderr, "error: %s:%d: %s: %s\n", batch.manifestFilename.c_str(), songs[i].lineNum, songs[i].args[0].c_str(), errors[i].c_str());
+            result = 1;
+        }
+    }
+
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        std::unique_ptr<Context> ctx(new Context());
+        std::string inputFilename;
+        std::string outputFilename;
+        BatchOptions batch;
+
+        if (!ParseArguments(argc, argv, *ctx, inputFilename, outputFilename, &batch))
+            PrintUsage();
+
+        if (!batch.manifestFilename.empty())
+        {
+            // Song options belong on the manifest lines.
+            if (!inputFilename.empty() || batch.hasSongOptions)
+                RaiseError("-M only takes -J; give the song files and options on the manifest lines");
+
+            return ConvertManifest(batch);
+        }
+
+        if (inputFilename.empty())
+            PrintUsage();
+
+        ConvertSong(*ctx, inputFilename, outputFilename);
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
 
     return 0;
 }
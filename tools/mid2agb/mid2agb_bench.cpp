@@ -0,0 +1,143 @@
+// Benchmarks converting MIDI files to assembly in memory, so that only the
+// MIDI parsing and the assembly printing are timed. Each file is read once
+// up front and converted with the default options plus any -E, -X or -N
+// given, with a fresh context every time, as mid2agb would.
+//
+// For example, over the largest songs:
+//   mid2agb_bench $(ls -S sound/songs/midi/*.mid | head -8)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include "context.h"
+#include "error.h"
+#include "midi.h"
+#include "agb.h"
+
+struct InputFile
+{
+    std::string path;
+    std::vector<std::uint8_t> data;
+    double bestMs;
+    std::size_t outputSize;
+};
+
+struct BenchOptions
+{
+    int iterations = 20;
+    bool exactGateTime = false;
+    bool compressionEnabled = true;
+    int clocksPerBeat = 1;
+};
+
+static void ConvertInMemory(const BenchOptions& options, const InputFile& input, std::size_t& outputSize)
+{
+    std::unique_ptr<Context> ctx(new Context());
+
+    ctx->exactGateTime = options.exactGateTime;
+    ctx->compressionEnabled = options.compressionEnabled;
+    ctx->clocksPerBeat = options.clocksPerBeat;
+    ctx->asmLabel = "bench";
+    ctx->input = input.data.data();
+    ctx->inputSize = input.data.size();
+
+    ReadMidiFileHeader(*ctx);
+    PrintAgbHeader(*ctx);
+    ReadMidiTracks(*ctx);
+    PrintAgbFooter(*ctx);
+
+    outputSize = ctx->output.size();
+}
+
+int main(int argc, char **argv)
+{
+    BenchOptions options;
+    std::vector<InputFile> inputs;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "-n") == 0)
+        {
+            if (i + 1 >= argc || (options.iterations = std::atoi(argv[i + 1])) < 1)
+            {
+                std::fprintf(stderr, "error: expected a positive number of iterations following \"-n\"\n");
+                return 1;
+            }
+            i++;
+        }
+        else if (std::strcmp(argv[i], "-E") == 0)
+        {
+            options.exactGateTime = true;
+        }
+        else if (std::strcmp(argv[i], "-X") == 0)
+        {
+            options.clocksPerBeat = 2;
+        }
+        else if (std::strcmp(argv[i], "-N") == 0)
+        {
+            options.compressionEnabled = false;
+        }
+        else
+        {
+            InputFile input;
+            input.path = argv[i];
+            inputs.push_back(input);
+        }
+    }
+
+    if (inputs.empty())
+    {
+        std::fprintf(stderr, "Usage: mid2agb_bench [-n ITERATIONS] [-E] [-X] [-N] MIDI_FILE...\n");
+        return 1;
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    double totalMs = 0;
+
+    try
+    {
+        for (InputFile& input : inputs)
+        {
+            std::ifstream file(input.path, std::ios::binary);
+
+            if (!file.is_open())
+                RaiseError("failed to open \"%s\" for reading", input.path.c_str());
+
+            input.data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            input.bestMs = 0;
+
+            for (int i = 0; i < options.iterations; i++)
+            {
+                Clock::time_point start = Clock::now();
+                ConvertInMemory(options, input, input.outputSize);
+                double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+                if (i == 0 || ms < input.bestMs)
+                    input.bestMs = ms;
+                totalMs += ms;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+
+    std::printf("%zu files, %d iterations, best time per conversion:\n", inputs.size(), options.iterations);
+
+    for (const InputFile& input : inputs)
+        std::printf("  %-50s %7zu bytes -> %8zu bytes  %8.3f ms\n", input.path.c_str(), input.data.size(), input.outputSize, input.bestMs);
+
+    std::printf("total: %.3f ms over all iterations\n", totalMs);
+
+    return 0;
+}
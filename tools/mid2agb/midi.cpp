@@ -24,8 +24,9 @@
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <unordered_map>
 #include "midi.h"
-#include "main.h"
+#include "context.h"
 #include "error.h"
 #include "agb.h"
 #include "tables.h"
@@ -38,89 +39,73 @@ enum class MidiEventCategory
     Invalid,
 };
 
-MidiFormat g_midiFormat;
-std::int_fast32_t g_midiTrackCount;
-std::int16_t g_midiTimeDiv;
-
-int g_midiChan;
-std::int32_t g_initialWait;
-
-static long s_trackDataStart;
-static std::vector<Event> s_seqEvents;
-static std::vector<Event> s_trackEvents;
-static std::int32_t s_absoluteTime;
-static int s_blockCount = 0;
-static int s_minNote;
-static int s_maxNote;
-static int s_runningStatus;
-
-void Seek(long offset)
+void Seek(Context& ctx, long offset)
 {
-    if (std::fseek(g_inputFile, offset, SEEK_SET) != 0)
-        RaiseError("failed to seek to %l", offset);
+    if (offset < 0)
+        RaiseError("failed to seek to %ld", offset);
+
+    ctx.inputPos = offset;
 }
 
-void Skip(long offset)
+void Skip(Context& ctx, long offset)
 {
-    if (std::fseek(g_inputFile, offset, SEEK_CUR) != 0)
-        RaiseError("failed to skip %l bytes", offset);
+    ctx.inputPos += offset;
 }
 
-std::string ReadSignature()
+std::string ReadSignature(Context& ctx)
 {
-    char signature[4];
-
-    if (std::fread(signature, 4, 1, g_inputFile) != 1)
+    if (ctx.inputPos >= ctx.inputSize || ctx.inputSize - ctx.inputPos < 4)
         RaiseError("failed to read signature");
 
-    return std::string(signature, 4);
+    std::string signature((const char *)ctx.input + ctx.inputPos, 4);
+    ctx.inputPos += 4;
+
+    return signature;
 }
 
-std::uint32_t ReadInt8()
+std::uint32_t ReadInt8(Context& ctx)
 {
-    int c = std::fgetc(g_inputFile);
-
-    if (c < 0)
+    if (ctx.inputPos >= ctx.inputSize)
         RaiseError("unexpected EOF");
 
-    return c;
+    return ctx.input[ctx.inputPos++];
 }
 
-std::uint32_t ReadInt16()
+std::uint32_t ReadInt16(Context& ctx)
 {
     std::uint32_t val = 0;
-    val |= ReadInt8() << 8;
-    val |= ReadInt8();
+    val |= ReadInt8(ctx) << 8;
+    val |= ReadInt8(ctx);
     return val;
 }
 
-std::uint32_t ReadInt24()
+std::uint32_t ReadInt24(Context& ctx)
 {
     std::uint32_t val = 0;
-    val |= ReadInt8() << 16;
-    val |= ReadInt8() << 8;
-    val |= ReadInt8();
+    val |= ReadInt8(ctx) << 16;
+    val |= ReadInt8(ctx) << 8;
+    val |= ReadInt8(ctx);
     return val;
 }
 
-std::uint32_t ReadInt32()
+std::uint32_t ReadInt32(Context& ctx)
 {
     std::uint32_t val = 0;
-    val |= ReadInt8() << 24;
-    val |= ReadInt8() << 16;
-    val |= ReadInt8() << 8;
-    val |= ReadInt8();
+    val |= ReadInt8(ctx) << 24;
+    val |= ReadInt8(ctx) << 16;
+    val |= ReadInt8(ctx) << 8;
+    val |= ReadInt8(ctx);
     return val;
 }
 
-std::uint32_t ReadVLQ()
+std::uint32_t ReadVLQ(Context& ctx)
 {
     std::uint32_t val = 0;
     std::uint32_t c;
 
     do
     {
-        c = ReadInt8();
+        c = ReadInt8(ctx);
         val <<= 7;
         val |= (c & 0x7F);
     } while (c & 0x80);
@@ -128,79 +113,79 @@ std::uint32_t ReadVLQ()
     return val;
 }
 
-void ReadMidiFileHeader()
+void ReadMidiFileHeader(Context& ctx)
 {
-    Seek(0);
+    Seek(ctx, 0);
 
-    if (ReadSignature() != "MThd")
+    if (ReadSignature(ctx) != "MThd")
         RaiseError("MIDI file header signature didn't match \"MThd\"");
 
-    std::uint32_t headerLength = ReadInt32();
+    std::uint32_t headerLength = ReadInt32(ctx);
 
     if (headerLength != 6)
         RaiseError("MIDI file header length isn't 6");
 
-    std::uint16_t midiFormat = ReadInt16();
+    std::uint16_t midiFormat = ReadInt16(ctx);
 
     if (midiFormat >= 2)
         RaiseError("unsupported MIDI format (%u)", midiFormat);
 
-    g_midiFormat = (MidiFormat)midiFormat;
-    g_midiTrackCount = ReadInt16();
-    g_midiTimeDiv = ReadInt16();
+    ctx.midiFormat = (MidiFormat)midiFormat;
+    ctx.midiTrackCount = ReadInt16(ctx);
+    ctx.midiTimeDiv = ReadInt16(ctx);
 
-    if (g_midiTimeDiv < 0)
-        RaiseError("unsupported MIDI time division (%d)", g_midiTimeDiv);
+    if (ctx.midiTimeDiv < 0)
+        RaiseError("unsupported MIDI time division (%d)", ctx.midiTimeDiv);
 }
 
-long ReadMidiTrackHeader(long offset)
+long ReadMidiTrackHeader(Context& ctx, long offset)
 {
-    Seek(offset);
+    Seek(ctx, offset);
 
-    if (ReadSignature() != "MTrk")
+    if (ReadSignature(ctx) != "MTrk")
         RaiseError("MIDI track header signature didn't match \"MTrk\"");
 
-    long size = ReadInt32();
+    long size = ReadInt32(ctx);
 
-    s_trackDataStart = std::ftell(g_inputFile);
+    ctx.trackDataStart = ctx.inputPos;
 
     return size + 8;
 }
 
-void StartTrack()
+void StartTrack(Context& ctx)
 {
-    Seek(s_trackDataStart);
-    s_absoluteTime = 0;
-    s_runningStatus = 0;
+    Seek(ctx, ctx.trackDataStart);
+    ctx.absoluteTime = 0;
+    ctx.runningStatus = 0;
 }
 
-void SkipEventData()
+void SkipEventData(Context& ctx)
 {
-    Skip(ReadVLQ());
+    Skip(ctx, ReadVLQ(ctx));
 }
 
-void DetermineEventCategory(MidiEventCategory& category, int& typeChan, int& size)
+void DetermineEventCategory(Context& ctx, MidiEventCategory& category, int& typeChan, int& size)
 {
-    typeChan = ReadInt8();
+    typeChan = ReadInt8(ctx);
 
     if (typeChan < 0x80)
     {
         // If data byte was found, use the running status.
-        ungetc(typeChan, g_inputFile);
-        typeChan = s_runningStatus;
+        ctx.inputPos--;
+        typeChan = ctx.runningStatus;
     }
 
     if (typeChan == 0xFF)
     {
         category = MidiEventCategory::Meta;
         size = 0;
-        s_runningStatus = 0;
+        ctx.runningStatus = 0;
     }
     else if (typeChan >= 0xF0)
     {
         category = MidiEventCategory::SysEx;
         size = 0;
-        s_runningStatus = 0;
+        ctx.runningStatus = 0;
     }
     else if (typeChan >= 0x80)
     {
@@ -216,7 +201,7 @@ void DetermineEventCategory(MidiEventCategory& category, int& typeChan, int& siz
             size = 2;
             break;
         }
-        s_runningStatus = typeChan;
+        ctx.runningStatus = typeChan;
     }
     else
     {
@@ -224,52 +209,53 @@ void DetermineEventCategory(MidiEventCategory& category, int& typeChan, int& siz
     }
 }
 
-void MakeBlockEvent(Event& event, EventType type)
+void MakeBlockEvent(Context& ctx, Event& event, EventType type)
 {
     event.type = type;
-    event.param1 = s_blockCount++;
+    event.param1 = ctx.blockCount++;
     event.param2 = 0;
 }
 
-std::string ReadEventText()
+std::string ReadEventText(Context& ctx)
 {
-    char buffer[2];
-    std::uint32_t length = ReadVLQ();
+    std::uint32_t length = ReadVLQ(ctx);
 
     if (length <= 2)
     {
-        if (fread(buffer, length, 1, g_inputFile) != 1)
+        // Empty text has always been rejected here too.
+        if (length == 0 || ctx.inputPos >= ctx.inputSize || ctx.inputSize - ctx.inputPos < length)
             RaiseError("failed to read event text");
-    }
-    else
-    {
-        Skip(length);
-        length = 0;
+
+        std::string text((const char *)ctx.input + ctx.inputPos, length);
+        ctx.inputPos += length;
+        return text;
     }
 
-    return std::string(buffer, length);
+    Skip(ctx, length);
+
+    return std::string();
 }
 
-bool ReadSeqEvent(Event& event)
+bool ReadSeqEvent(Context& ctx, Event& event)
 {
-    s_absoluteTime += ReadVLQ();
-    event.time = s_absoluteTime;
+    ctx.absoluteTime += ReadVLQ(ctx);
+    event.time = ctx.absoluteTime;
 
     MidiEventCategory category;
     int typeChan;
     int size;
 
-    DetermineEventCategory(category, typeChan, size);
+    DetermineEventCategory(ctx, category, typeChan, size);
 
     if (category == MidiEventCategory::Control)
     {
-        Skip(size);
+        Skip(ctx, size);
         return false;
     }
 
     if (category == MidiEventCategory::SysEx)
     {
-        SkipEventData();
+        SkipEventData(ctx);
         return false;
     }
 
@@ -277,21 +263,21 @@ bool ReadSeqEvent(Event& event)
         RaiseError("invalid event");
 
     // meta event
-    int metaEventType = ReadInt8();
+    int metaEventType = ReadInt8(ctx);
 
     if (metaEventType >= 1 && metaEventType <= 7)
     {
         // text event
-        std::string text = ReadEventText();
+        std::string text = ReadEventText(ctx);
 
         if (text == "[")
-            MakeBlockEvent(event, EventType::LoopBegin);
+            MakeBlockEvent(ctx, event, EventType::LoopBegin);
         else if (text == "][")
-            MakeBlockEvent(event, EventType::LoopEndBegin);
+            MakeBlockEvent(ctx, event, EventType::LoopEndBegin);
         else if (text == "]")
-            MakeBlockEvent(event, EventType::LoopEnd);
+            MakeBlockEvent(ctx, event, EventType::LoopEnd);
         else if (text == ":")
-            MakeBlockEvent(event, EventType::Label);
+            MakeBlockEvent(ctx, event, EventType::Label);
         else
             return false;
     }
@@ -300,33 +286,33 @@ bool ReadSeqEvent(Event& event)
         switch (metaEventType)
         {
         case 0x2F: // end of track
-            SkipEventData();
+            SkipEventData(ctx);
             event.type = EventType::EndOfTrack;
             event.param1 = 0;
             event.param2 = 0;
             break;
         case 0x51: // tempo
-            if (ReadVLQ() != 3)
+            if (ReadVLQ(ctx) != 3)
                 RaiseError("invalid tempo size");
 
             event.type = EventType::Tempo;
             event.param1 = 0;
-            event.param2 = ReadInt24();
+            event.param2 = ReadInt24(ctx);
             break;
         case 0x58: // time signature
         {
-            if (ReadVLQ() != 4)
+            if (ReadVLQ(ctx) != 4)
                 RaiseError("invalid time signature size");
 
-            int numerator = ReadInt8();
-            int denominatorExponent = ReadInt8();
+            int numerator = ReadInt8(ctx);
+            int denominatorExponent = ReadInt8(ctx);
 
             if (denominatorExponent >= 16)
                 RaiseError("invalid time signature denominator");
 
-            Skip(2); // ignore other values
+            Skip(ctx, 2); // ignore other values
 
-            int clockTicks = 96 * numerator * g_clocksPerBeat;
+            int clockTicks = 96 * numerator * ctx.clocksPerBeat;
             int denominator = 1 << denominatorExponent;
             int timeSig = clockTicks / denominator;
 
@@ -339,7 +325,7 @@ bool ReadSeqEvent(Event& event)
             break;
         }
         default:
-            SkipEventData();
+            SkipEventData(ctx);
             return false;
         }
     }
@@ -347,17 +333,17 @@ bool ReadSeqEvent(Event& event)
     return true;
 }
 
-void ReadSeqEvents()
+void ReadSeqEvents(Context& ctx)
 {
-    StartTrack();
+    StartTrack(ctx);
 
     for (;;)
     {
         Event event = {};
 
-        if (ReadSeqEvent(event))
+        if (ReadSeqEvent(ctx, event))
         {
-            s_seqEvents.push_back(event);
+            ctx.seqEvents.push_back(event);
 
             if (event.type == EventType::EndOfTrack)
                 return;
@@ -365,201 +351,155 @@ void ReadSeqEvents()
     }
 }
 
-bool CheckNoteEnd(Event& event)
+// Decodes every channel message of the current track in a single pass.
+// Everything else except the end of track is skipped.
+void ReadChannelMessages(Context& ctx)
 {
-    event.param2 += ReadVLQ();
-
-    MidiEventCategory category;
-    int typeChan;
-    int size;
+    StartTrack(ctx);
 
-    DetermineEventCategory(category, typeChan, size);
+    ctx.channelMessages.clear();
 
-    if (category == MidiEventCategory::Control)
+    for (;;)
     {
-        int chan = typeChan & 0xF;
+        ctx.absoluteTime += ReadVLQ(ctx);
 
-        if (chan != g_midiChan)
-        {
-            Skip(size);
-            return false;
-        }
+        MidiEventCategory category;
+        int typeChan;
+        int size;
+
+        DetermineEventCategory(ctx, category, typeChan, size);
 
-        switch (typeChan & 0xF0)
+        if (category == MidiEventCategory::Control)
         {
-        case 0x80: // note off
+            ChannelMessage message = {};
+            message.time = ctx.absoluteTime;
+            message.typeChan = typeChan;
+            message.data1 = ReadInt8(ctx);
+
+            if (size == 2)
+                message.data2 = ReadInt8(ctx);
+
+            ctx.channelMessages.push_back(message);
+        }
+        else if (category == MidiEventCategory::SysEx)
         {
-            int note = ReadInt8();
-            ReadInt8(); // ignore velocity
-            if (note == event.note)
-                return true;
-            break;
+            SkipEventData(ctx);
         }
-        case 0x90: // note on
+        else if (category == MidiEventCategory::Meta)
         {
-            int note = ReadInt8();
-            int velocity = ReadInt8();
-            if (velocity == 0 && note == event.note)
-                return true;
-            break;
+            int metaEventType = ReadInt8(ctx);
+            SkipEventData(ctx);
+
+            if (metaEventType == 0x2F)
+            {
+                ctx.endOfTrackTime = ctx.absoluteTime;
+                return;
+            }
         }
-        default:
-            Skip(size);
-            break;
+        else
+        {
+            RaiseError("invalid event");
         }
-
-        return false;
     }
-
-    if (category == MidiEventCategory::SysEx)
-    {
-        SkipEventData();
-        return false;
-    }
-
-    if (category == MidiEventCategory::Meta)
-    {
-        int metaEventType = ReadInt8();
-        SkipEventData();
-
-        if (metaEventType == 0x2F)
-            RaiseError("note doesn't end");
-
-        return false;
-    }
-
-    RaiseError("invalid event");
 }
 
-void FindNoteEnd(Event& event)
+void EndPendingNotes(Context& ctx, int chan, int note, std::int32_t time)
 {
-    // Save the current file position and running status
-    // which get modified by CheckNoteEnd.
-    long startPos = ftell(g_inputFile);
-    int savedRunningStatus = s_runningStatus;
+    std::vector<unsigned>& pendingNotes = ctx.pendingNotes[chan][note];
 
-    event.param2 = 0;
+    for (unsigned index : pendingNotes)
+    {
+        Event& event = ctx.channelEvents[chan][index];
+        event.param2 = time - event.time;
 
-    while (!CheckNoteEnd(event))
-        ;
+        if (event.param2 > 0)
+        {
+            if (note < ctx.minNote[chan])
+                ctx.minNote[chan] = note;
+            if (note > ctx.maxNote[chan])
+                ctx.maxNote[chan] = note;
+        }
+    }
 
-    Seek(startPos);
-    s_runningStatus = savedRunningStatus;
+    pendingNotes.clear();
 }
 
-bool ReadTrackEvent(Event& event)
+void ReadTrackEvents(Context& ctx)
 {
-    s_absoluteTime += ReadVLQ();
-    event.time = s_absoluteTime;
-
-    MidiEventCategory category;
-    int typeChan;
-    int size;
+    ReadChannelMessages(ctx);
 
-    DetermineEventCategory(category, typeChan, size);
+    for (int chan = 0; chan < 16; chan++)
+    {
+        ctx.channelEvents[chan].clear();
+        ctx.minNote[chan] = 0xFF;
+        ctx.maxNote[chan] = 0;
+    }
 
-    if (category == MidiEventCategory::Control)
+    for (const ChannelMessage& message : ctx.channelMessages)
     {
-        int chan = typeChan & 0xF;
+        int chan = message.typeChan & 0xF;
+        int type = message.typeChan & 0xF0;
 
-        if (chan != g_midiChan)
-        {
-            Skip(size);
-            return false;
-        }
+        // Keys are data bytes, so anything above 127 isn't a note.
+        if ((type == 0x80 || type == 0x90) && message.data1 > 127)
+            RaiseError("invalid note");
 
-        switch (typeChan & 0xF0)
+        Event event = {};
+        event.time = message.time;
+
+        switch (type)
         {
+        case 0x80: // note off
+            EndPendingNotes(ctx, chan, message.data1, message.time);
+            continue;
         case 0x90: // note on
-        {
-            int note = ReadInt8();
-            int velocity = ReadInt8();
-
-            if (velocity != 0)
+            // A note on with velocity 0 ends the note but still leaves
+            // an empty event behind.
+            if (message.data2 == 0)
+            {
+                EndPendingNotes(ctx, chan, message.data1, message.time);
+            }
+            else
             {
                 event.type = EventType::Note;
-                event.note = note;
-                event.param1 = velocity;
-                FindNoteEnd(event);
-                if (event.param2 > 0)
-                {
-                    if (note < s_minNote)
-                        s_minNote = note;
-                    if (note > s_maxNote)
-                        s_maxNote = note;
-                }
+                event.note = message.data1;
+                event.param1 = message.data2;
+                ctx.pendingNotes[chan][event.note].push_back(ctx.channelEvents[chan].size());
             }
             break;
-        }
         case 0xB0: // controller event
             event.type = EventType::Controller;
-            event.param1 = ReadInt8(); // controller index
-            event.param2 = ReadInt8(); // value
+            event.param1 = message.data1; // controller index
+            event.param2 = message.data2; // value
             break;
         case 0xC0: // instrument change
             event.type = EventType::InstrumentChange;
-            event.param1 = ReadInt8(); // instrument
+            event.param1 = message.data1; // instrument
             event.param2 = 0;
             break;
         case 0xE0: // pitch bend
             event.type = EventType::PitchBend;
-            event.param1 = ReadInt8();
-            event.param2 = ReadInt8();
+            event.param1 = message.data1;
+            event.param2 = message.data2;
             break;
         default:
-            Skip(size);
-            return false;
+            continue;
         }
 
-        return true;
-    }
-
-    if (category == MidiEventCategory::SysEx)
-    {
-        SkipEventData();
-        return false;
+        ctx.channelEvents[chan].push_back(event);
     }
 
-    if (category == MidiEventCategory::Meta)
-    {
-        int metaEventType = ReadInt8();
-        SkipEventData();
-
-        if (metaEventType == 0x2F)
-        {
-            event.type = EventType::EndOfTrack;
-            event.param1 = 0;
-            event.param2 = 0;
-            return true;
-        }
-
-        return false;
-    }
-
-    RaiseError("invalid event");
-}
-
-void ReadTrackEvents()
-{
-    StartTrack();
-
-    s_trackEvents.clear();
+    for (int chan = 0; chan < 16; chan++)
+        for (int note = 0; note < 128; note++)
+            if (!ctx.pendingNotes[chan][note].empty())
+                RaiseError("note doesn't end");
 
-    s_minNote = 0xFF;
-    s_maxNote = 0;
+    Event endOfTrack = {};
+    endOfTrack.time = ctx.endOfTrackTime;
+    endOfTrack.type = EventType::EndOfTrack;
 
-    for (;;)
-    {
-        Event event = {};
-
-        if (ReadTrackEvent(event))
-        {
-            s_trackEvents.push_back(event);
-
-            if (event.type == EventType::EndOfTrack)
-                return;
-        }
-    }
+    for (int chan = 0; chan < 16; chan++)
+        ctx.channelEvents[chan].push_back(endOfTrack);
 }
 
 bool EventCompare(const Event& event1, const Event& event2)
@@ -597,53 +537,53 @@ bool EventCompare(const Event& event1, const Event& event2)
     return false;
 }
 
-std::unique_ptr<std::vector<Event>> MergeEvents()
+std::unique_ptr<std::vector<Event>> MergeEvents(Context& ctx)
 {
     std::unique_ptr<std::vector<Event>> events(new std::vector<Event>());
 
     unsigned trackEventPos = 0;
     unsigned seqEventPos = 0;
 
-    while (s_trackEvents[trackEventPos].type != EventType::EndOfTrack
-        && s_seqEvents[seqEventPos].type != EventType::EndOfTrack)
+    while (ctx.trackEvents[trackEventPos].type != EventType::EndOfTrack
+        && ctx.seqEvents[seqEventPos].type != EventType::EndOfTrack)
     {
-        if (EventCompare(s_trackEvents[trackEventPos], s_seqEvents[seqEventPos]))
-            events->push_back(s_trackEvents[trackEventPos++]);
+        if (EventCompare(ctx.trackEvents[trackEventPos], ctx.seqEvents[seqEventPos]))
+            events->push_back(ctx.trackEvents[trackEventPos++]);
         else
-            events->push_back(s_seqEvents[seqEventPos++]);
+            events->push_back(ctx.seqEvents[seqEventPos++]);
     }
 
-    while (s_trackEvents[trackEventPos].type != EventType::EndOfTrack)
-        events->push_back(s_trackEvents[trackEventPos++]);
+    while (ctx.trackEvents[trackEventPos].type != EventType::EndOfTrack)
+        events->push_back(ctx.trackEvents[trackEventPos++]);
 
-    while (s_seqEvents[seqEventPos].type != EventType::EndOfTrack)
-        events->push_back(s_seqEvents[seqEventPos++]);
+    while (ctx.seqEvents[seqEventPos].type != EventType::EndOfTrack)
+        events->push_back(ctx.seqEvents[seqEventPos++]);
 
     // Push the EndOfTrack event with the larger time.
-    if (EventCompare(s_trackEvents[trackEventPos], s_seqEvents[seqEventPos]))
-        events->push_back(s_seqEvents[seqEventPos]);
+    if (EventCompare(ctx.trackEvents[trackEventPos], ctx.seqEvents[seqEventPos]))
+        events->push_back(ctx.seqEvents[seqEventPos]);
     else
-        events->push_back(s_trackEvents[trackEventPos]);
+        events->push_back(ctx.trackEvents[trackEventPos]);
 
     return events;
 }
 
-void ConvertTimes(std::vector<Event>& events)
+void ConvertTimes(Context& ctx, std::vector<Event>& events)
 {
     for (Event& event : events)
     {
-        event.time = (24 * g_clocksPerBeat * event.time) / g_midiTimeDiv;
+        event.time = (24 * ctx.clocksPerBeat * event.time) / ctx.midiTimeDiv;
 
         if (event.type == EventType::Note)
         {
             event.param1 = g_noteVelocityLUT[event.param1];
 
-            std::uint32_t duration = (24 * g_clocksPerBeat * event.param2) / g_midiTimeDiv;
+            std::uint32_t duration = (24 * ctx.clocksPerBeat * event.param2) / ctx.midiTimeDiv;
 
             if (duration == 0)
                 duration = 1;
 
-            if (!g_exactGateTime && duration < 96)
+            if (!ctx.exactGateTime && duration < 96)
                 duration = g_noteDurationLUT[duration];
 
             event.param2 = duration;
@@ -651,14 +591,14 @@ void ConvertTimes(std::vector<Event>& events)
     }
 }
 
-std::unique_ptr<std::vector<Event>> InsertTimingEvents(std::vector<Event>& inEvents)
+std::unique_ptr<std::vector<Event>> InsertTimingEvents(Context& ctx, std::vector<Event>& inEvents)
 {
     std::unique_ptr<std::vector<Event>> outEvents(new std::vector<Event>());
 
     Event timingEvent = {};
     timingEvent.time = 0;
     timingEvent.type = EventType::TimeSignature;
-    timingEvent.param2 = 96 * g_clocksPerBeat;
+    timingEvent.param2 = 96 * ctx.clocksPerBeat;
 
     for (const Event& event : inEvents)
     {
@@ -670,7 +610,7 @@ std::unique_ptr<std::vector<Event>> InsertTimingEvents(std::vector<Event>& inEve
 
         if (event.type == EventType::TimeSignature)
         {
-            if (g_agbTrack == 1 && event.param2 != timingEvent.param2)
+            if (ctx.agbTrack == 1 && event.param2 != timingEvent.param2)
             {
                 Event originalTimingEvent = event;
                 originalTimingEvent.type = EventType::OriginalTimeSignature;
@@ -756,9 +696,9 @@ std::unique_ptr<std::vector<Event>> CreateTies(std::vector<Event>& inEvents)
     return outEvents;
 }
 
-void CalculateWaits(std::vector<Event>& events)
+void CalculateWaits(Context& ctx, std::vector<Event>& events)
 {
-    g_initialWait = events[0].time;
+    ctx.initialWait = events[0].time;
     int wholeNoteCount = 0;
 
     for (unsigned i = 0; i < events.size() && events[i].type != EventType::EndOfTrack; i++)
@@ -873,91 +813,118 @@ bool IsCompressionMatch(std::vector<Event>& events, int index1, int index2)
     return IsPatternBoundary(events[index2].type);
 }
 
-void CompressWholeNote(std::vector<Event>& events, int index)
+std::uint32_t HashWholeNote(std::vector<Event>& events, int index)
 {
-    for (int j = index + 1; events[j].type != EventType::EndOfTrack; j++)
+    // Covers exactly the fields compared by IsCompressionMatch.
+    std::uint32_t hash = 2166136261u;
+
+    auto mix = [&hash](std::uint32_t value)
     {
-        while (events[j].type != EventType::WholeNoteMark)
-        {
-            j++;
+        hash = (hash ^ value) * 16777619u;
+    };
 
-            if (events[j].type == EventType::EndOfTrack)
-                return;
-        }
+    mix((std::uint32_t)events[index].type);
+    mix(events[index].note);
+    mix(events[index].param1);
+    mix(events[index].time);
 
-        if (IsCompressionMatch(events, index, j))
-        {
-            events[j].type = EventType::Pattern;
-            events[j].param2 = events[index].param2 & 0x7FFFFFFF;
-            events[index].param2 |= 0x80000000;
-        }
+    for (int i = index + 1; !IsPatternBoundary(events[i].type); i++)
+    {
+        mix(events[i].time);
+        mix((std::uint32_t)events[i].type);
+        mix(events[i].note);
+        mix(events[i].param1);
+        mix(events[i].param2);
     }
+
+    return hash;
 }
 
 void Compress(std::vector<Event>& events)
 {
+    // Whole notes that later identical whole notes can be turned into
+    // patterns of, by hash.
+    std::unordered_multimap<std::uint32_t, int> patterns;
+
     for (int i = 0; events[i].type != EventType::EndOfTrack; i++)
     {
-        while (events[i].type != EventType::WholeNoteMark)
-        {
-            i++;
+        if (events[i].type != EventType::WholeNoteMark)
+            continue;
 
-            if (events[i].type == EventType::EndOfTrack)
-                return;
-        }
+        // A whole note and its matches always have the same score.
+        if (CalculateCompressionScore(events, i) < 6)
+            continue;
+
+        std::uint32_t hash = HashWholeNote(events, i);
+        auto range = patterns.equal_range(hash);
+        auto it = range.first;
 
-        if (CalculateCompressionScore(events, i) >= 6)
+        while (it != range.second && !IsCompressionMatch(events, it->second, i))
+            ++it;
+
+        if (it == range.second)
+        {
+            patterns.emplace(hash, i);
+        }
+        else
         {
-            CompressWholeNote(events, i);
+            int index = it->second;
+            events[i].type = EventType::Pattern;
+            events[i].param2 = events[index].param2 & 0x7FFFFFFF;
+            events[index].param2 |= 0x80000000;
         }
     }
 }
 
-void ReadMidiTracks()
+void ReadMidiTracks(Context& ctx)
 {
     long trackHeaderStart = 14;
 
-    ReadMidiTrackHeader(trackHeaderStart);
-    ReadSeqEvents();
+    ReadMidiTrackHeader(ctx, trackHeaderStart);
+    ReadSeqEvents(ctx);
 
-    g_agbTrack = 1;
+    ctx.agbTrack = 1;
 
-    for (int midiTrack = 0; midiTrack < g_midiTrackCount; midiTrack++)
+    for (int midiTrack = 0; midiTrack < ctx.midiTrackCount; midiTrack++)
     {
-        trackHeaderStart += ReadMidiTrackHeader(trackHeaderStart);
+        trackHeaderStart += ReadMidiTrackHeader(ctx, trackHeaderStart);
+        ReadTrackEvents(ctx);
 
-        for (g_midiChan = 0; g_midiChan < 16; g_midiChan++)
+        for (ctx.midiChan = 0; ctx.midiChan < 16; ctx.midiChan++)
         {
-            ReadTrackEvents();
-
-            if (s_minNote != 0xFF)
+            if (ctx.minNote[ctx.midiChan] != 0xFF)
             {
+                ctx.trackEvents.swap(ctx.channelEvents[ctx.midiChan]);
+
 #ifdef DEBUG
-                printf("Track%d = Midi-Ch.%d\n", g_agbTrack, g_midiChan + 1);
+                printf("Track%d = Midi-Ch.%d\n", ctx.agbTrack, ctx.midiChan + 1);
 #endif
 
-                std::unique_ptr<std::vector<Event>> events(MergeEvents());
+                std::unique_ptr<std::vector<Event>> events(MergeEvents(ctx));
 
                 // We don't need TEMPO in anything but track 1.
-                if (g_agbTrack == 1)
+                if (ctx.agbTrack == 1)
                 {
-                    auto it = std::remove_if(s_seqEvents.begin(), s_seqEvents.end(), [](const Event& event) { return event.type == EventType::Tempo; });
-                    s_seqEvents.erase(it, s_seqEvents.end());
+                    auto it = std::remove_if(ctx.seqEvents.begin(), ctx.seqEvents.end(), [](const Event& event) { return event.type == EventType::Tempo; });
+                    ctx.seqEvents.erase(it, ctx.seqEvents.end());
                 }
 
-                ConvertTimes(*events);
-                events = InsertTimingEvents(*events);
+                ConvertTimes(ctx, *events);
+                events = InsertTimingEvents(ctx, *events);
                 events = CreateTies(*events);
                 std::stable_sort(events->begin(), events->end(), EventCompare);
                 events = SplitTime(*events);
-                CalculateWaits(*events);
+                CalculateWaits(ctx, *events);
 
-                if (g_compressionEnabled)
+                if (ctx.compressionEnabled)
                     Compress(*events);
 
-                PrintAgbTrack(*events);
+                if (!ctx.reportFilename.empty())
+                    ReportTrack(ctx, *events);
+
+                PrintAgbTrack(ctx, *events);
 
-                g_agbTrack++;
+                ctx.agbTrack++;
             }
         }
     }
@@ -73,11 +73,18 @@ struct Event
     }
 };
 
-void ReadMidiFileHeader();
-void ReadMidiTracks();
+struct ChannelMessage
+{
+    std::int32_t time;
+    std::uint8_t typeChan;
+    std::uint8_t data1;
+    std::uint8_t data2;
+};
+
+struct Context;
 
-extern int g_midiChan;
-extern std::int32_t g_initialWait;
+void ReadMidiFileHeader(Context& ctx);
+void ReadMidiTracks(Context& ctx);
 
 inline bool IsPatternBoundary(EventType type)
 {
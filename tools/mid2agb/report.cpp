@@ -0,0 +1,310 @@
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "report.h"
+#include "context.h"
+#include "error.h"
+
+// m4a advances a song by one tick each time the tempo accumulated over
+// frames reaches this value.
+static const int kTempoTickThreshold = 150;
+
+// The engine starts at this tempo until the first TEMPO command.
+static const int kDefaultTempo = 150;
+
+static int CountAt(std::vector<int>& counts, std::int32_t tick)
+{
+    if (tick < 0)
+        tick = 0;
+
+    if ((std::size_t)tick >= counts.size())
+        counts.resize(tick + 1);
+
+    return ++counts[tick];
+}
+
+static int PeakPolyphony(std::vector<std::int32_t> starts, std::vector<std::int32_t> ends)
+{
+    std::sort(starts.begin(), starts.end());
+    std::sort(ends.begin(), ends.end());
+
+    int polyphony = 0;
+    int peak = 0;
+    std::size_t j = 0;
+
+    // A note ending on the same tick another starts frees its channel first.
+    for (std::int32_t start : starts)
+    {
+        while (j < ends.size() && ends[j] <= start)
+        {
+            polyphony--;
+            j++;
+        }
+
+        polyphony++;
+        peak = std::max(peak, polyphony);
+    }
+
+    return peak;
+}
+
+// Takes the final events of a track, after CalculateWaits and Compress.
+void ReportTrack(Context& ctx, const std::vector<Event>& events)
+{
+    SongReport& report = ctx.report;
+    TrackReport track;
+    track.agbTrack = ctx.agbTrack;
+    track.midiChan = ctx.midiChan;
+
+    std::vector<int> notesPerTick;
+    std::vector<std::int32_t> starts;
+    std::vector<std::int32_t> ends;
+    std::vector<std::int32_t> tieStarts[256];
+    std::int32_t time = ctx.initialWait;
+
+    for (int i = 0; events[i].type != EventType::EndOfTrack; i++)
+    {
+        const Event& event = events[i];
+        bool command = true;
+
+        switch (event.type)
+        {
+        case EventType::Note:
+            track.notes++;
+            track.notesPerTickPeak = std::max(track.notesPerTickPeak, CountAt(notesPerTick, time));
+            CountAt(report.notesPerTick, time);
+            starts.push_back(time);
+
+            if (event.param2 == -1)
+            {
+                track.ties++;
+                tieStarts[event.note].push_back(time);
+            }
+            else
+            {
+                ends.push_back(time + event.param2);
+            }
+            break;
+        case EventType::EndOfTie:
+            if (!tieStarts[event.note].empty())
+            {
+                tieStarts[event.note].pop_back();
+                ends.push_back(time);
+            }
+            break;
+        case EventType::Controller:
+            track.controllers++;
+            break;
+        case EventType::PitchBend:
+            track.pitchBends++;
+            break;
+        case EventType::InstrumentChange:
+            track.voiceChanges++;
+            break;
+        case EventType::Tempo:
+            track.tempoChanges++;
+        {
+            TempoChange tempo;
+            tempo.time = time;
+            tempo.bpm = (int)std::round(60000000.0f / (float)event.param2);
+            tempo.engineTempo = tempo.bpm * ctx.clocksPerBeat / 2 * 2;
+            report.tempos.push_back(tempo);
+            break;
+        }
+        case EventType::LoopEnd:
+        case EventType::LoopEndBegin:
+            break;
+        case EventType::WholeNoteMark:
+            if (event.param2 & 0x80000000)
+                track.patterns++;
+            command = false;
+            break;
+        case EventType::Pattern:
+        {
+            track.patternCalls++;
+            int patternEnd = i + 1;
+            while (!IsPatternBoundary(events[patternEnd].type))
+                patternEnd++;
+            track.eventsReplaced += patternEnd - (i + 1);
+            break;
+        }
+        default:
+            command = false;
+            break;
+        }
+
+        if (command)
+        {
+            track.commands++;
+            CountAt(report.commandsPerTick, time);
+        }
+
+        if (event.time > 0)
+        {
+            track.waits++;
+            track.commands++;
+            CountAt(report.commandsPerTick, time);
+        }
+
+        time += event.time;
+    }
+
+    // Notes still tied at the end of the track ring until it ends.
+    for (int note = 0; note < 256; note++)
+        for (std::size_t j = 0; j < tieStarts[note].size(); j++)
+            ends.push_back(time);
+
+    track.polyphonyPeak = PeakPolyphony(starts, ends);
+
+    report.noteStarts.insert(report.noteStarts.end(), starts.begin(), starts.end());
+    report.noteEnds.insert(report.noteEnds.end(), ends.begin(), ends.end());
+    report.length = std::max(report.length, time);
+    report.tracks.push_back(track);
+}
+
+static std::string EscapeJson(const std::string& s)
+{
+    std::string escaped;
+
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            // JSON strings can't hold control characters as they are.
+            char buffer[7];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned char)c);
+            escaped += buffer;
+        }
+        else
+        {
+            escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+void WriteReport(const Context& ctx, const std::string& inputFilename, const std::string& path)
+{
+    const SongReport& report = ctx.report;
+
+    // Play the song back frame by frame the way m4a does to find out how
+    // much has to be decoded in the worst frames.
+    std::vector<TempoChange> tempos = report.tempos;
+    std::stable_sort(tempos.begin(), tempos.end(), [](const TempoChange& a, const TempoChange& b) { return a.time < b.time; });
+
+    int tempo = kDefaultTempo;
+    int minBpm = 0;
+    int maxBpm = 0;
+
+    for (const TempoChange& change : tempos)
+    {
+        if (minBpm == 0 || change.bpm < minBpm)
+            minBpm = change.bpm;
+        maxBpm = std::max(maxBpm, change.bpm);
+    }
+    std::size_t nextTempo = 0;
+    int tempoCounter = 0;
+    std::int32_t tick = 0;
+    long frames = 0;
+    long totalCommands = 0;
+    int commandsPerFramePeak = 0;
+    int notesPerFramePeak = 0;
+    int ticksPerFramePeak = 0;
+
+    while (tick <= report.length)
+    {
+        int commands = 0;
+        int notes = 0;
+        int ticks = 0;
+
+        tempoCounter += tempo;
+
+        while (tempoCounter >= kTempoTickThreshold && tick <= report.length)
+        {
+            tempoCounter -= kTempoTickThreshold;
+
+            if ((std::size_t)tick < report.commandsPerTick.size())
+                commands += report.commandsPerTick[tick];
+            if ((std::size_t)tick < report.notesPerTick.size())
+                notes += report.notesPerTick[tick];
+
+            while (nextTempo < tempos.size() && tempos[nextTempo].time <= tick)
+                tempo = tempos[nextTempo++].engineTempo;
+
+            tick++;
+            ticks++;
+        }
+
+        // A zero tempo would never get anywhere.
+        if (tempo <= 0)
+            break;
+
+        frames++;
+        totalCommands += commands;
+        commandsPerFramePeak = std::max(commandsPerFramePeak, commands);
+        notesPerFramePeak = std::max(notesPerFramePeak, notes);
+        ticksPerFramePeak = std::max(ticksPerFramePeak, ticks);
+    }
+
+    int notesPerTickPeak = 0;
+
+    for (int count : report.notesPerTick)
+        notesPerTickPeak = std::max(notesPerTickPeak, count);
+
+    FILE *fp = std::fopen(path.c_str(), "w");
+
+    if (fp == nullptr)
+        RaiseError("failed to open \"%s\" for writing", path.c_str());
+
+    std::fprintf(fp, "{\n");
+    std::fprintf(fp, "    \"song\": \"%s\",\n", EscapeJson(ctx.asmLabel).c_str());
+    std::fprintf(fp, "    \"input\": \"%s\",\n", EscapeJson(inputFilename).c_str());
+    std::fprintf(fp, "    \"ticksPerBeat\": %d,\n", 24 * ctx.clocksPerBeat);
+    std::fprintf(fp, "    \"lengthTicks\": %d,\n", report.length);
+    std::fprintf(fp, "    \"bpmMin\": %d,\n", minBpm);
+    std::fprintf(fp, "    \"bpmMax\": %d,\n", maxBpm);
+    std::fprintf(fp, "    \"frames\": %ld,\n", frames);
+    std::fprintf(fp, "    \"ticksPerFramePeak\": %d,\n", ticksPerFramePeak);
+    std::fprintf(fp, "    \"commandsPerFramePeak\": %d,\n", commandsPerFramePeak);
+    std::fprintf(fp, "    \"commandsPerFrameAverage\": %.2f,\n", frames > 0 ? (double)totalCommands / frames : 0.0);
+    std::fprintf(fp, "    \"notesPerFramePeak\": %d,\n", notesPerFramePeak);
+    std::fprintf(fp, "    \"notesPerTickPeak\": %d,\n", notesPerTickPeak);
+    std::fprintf(fp, "    \"polyphonyPeak\": %d,\n", PeakPolyphony(report.noteStarts, report.noteEnds));
+    std::fprintf(fp, "    \"tracks\": [");
+
+    for (std::size_t i = 0; i < report.tracks.size(); i++)
+    {
+        const TrackReport& track = report.tracks[i];
+
+        std::fprintf(fp, "%s\n        {\n", i > 0 ? "," : "");
+        std::fprintf(fp, "            \"track\": %d,\n", track.agbTrack);
+        std::fprintf(fp, "            \"midiChannel\": %d,\n", track.midiChan + 1);
+        std::fprintf(fp, "            \"commands\": %d,\n", track.commands);
+        std::fprintf(fp, "            \"notes\": %d,\n", track.notes);
+        std::fprintf(fp, "            \"ties\": %d,\n", track.ties);
+        std::fprintf(fp, "            \"controllers\": %d,\n", track.controllers);
+        std::fprintf(fp, "            \"pitchBends\": %d,\n", track.pitchBends);
+        std::fprintf(fp, "            \"voiceChanges\": %d,\n", track.voiceChanges);
+        std::fprintf(fp, "            \"tempoChanges\": %d,\n", track.tempoChanges);
+        std::fprintf(fp, "            \"waits\": %d,\n", track.waits);
+        std::fprintf(fp, "            \"notesPerTickPeak\": %d,\n", track.notesPerTickPeak);
+        std::fprintf(fp, "            \"polyphonyPeak\": %d,\n", track.polyphonyPeak);
+        std::fprintf(fp, "            \"patterns\": %d,\n", track.patterns);
+        std::fprintf(fp, "            \"patternCalls\": %d,\n", track.patternCalls);
+        std::fprintf(fp, "            \"eventsReplaced\": %d\n", track.eventsReplaced);
+        std::fprintf(fp, "        }");
+    }
+
+    std::fprintf(fp, "\n    ]\n}\n");
+
+    if (std::fclose(fp) != 0)
+        RaiseError("failed to write \"%s\"", path.c_str());
+}
@@ -0,0 +1,60 @@
+#ifndef REPORT_H
+#define REPORT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "midi.h"
+
+struct Context;
+
+struct TrackReport
+{
+    int agbTrack = 0;
+    int midiChan = 0;
+    int notes = 0;
+    int ties = 0;
+    int controllers = 0;
+    int pitchBends = 0;
+    int voiceChanges = 0;
+    int tempoChanges = 0;
+    int waits = 0;
+    int commands = 0;
+    int notesPerTickPeak = 0;
+    int polyphonyPeak = 0;
+    int patterns = 0;
+    int patternCalls = 0;
+    int eventsReplaced = 0;
+};
+
+struct TempoChange
+{
+    std::int32_t time;
+    int bpm;
+    // What m4a adds to its tempo counter every frame (TEMPO parameter * 2).
+    int engineTempo;
+};
+
+// Statistics gathered while converting a song, written out as JSON by
+// --report to judge how hard the song works the m4a sound engine.
+struct SongReport
+{
+    std::vector<TrackReport> tracks;
+
+    // Commands and note starts decoded at each tick, over all tracks.
+    std::vector<int> commandsPerTick;
+    std::vector<int> notesPerTick;
+
+    // Start and end ticks of every note, over all tracks.
+    std::vector<std::int32_t> noteStarts;
+    std::vector<std::int32_t> noteEnds;
+
+    std::vector<TempoChange> tempos;
+
+    std::int32_t length = 0;
+};
+
+void ReportTrack(Context& ctx, const std::vector<Event>& events);
+void WriteReport(const Context& ctx, const std::string& inputFilename, const std::string& path);
+
+#endif // REPORT_H
@@ -1,236 +1,257 @@
 #include <cstdio>
 #include <cstring>
 #include <cstdint>
+#include <cstdlib>
 #include <map>
 #include <vector>
 #include <string>
 #include "ramscrgen.h"
 #include "elf.h"
 
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #define SHN_COMMON 0xFFF2
 
 static std::string s_elfPath;
 static std::string s_archiveFilePath;
 static std::string s_archiveObjectPath;
 
-static FILE *s_file;
+// The whole of a file, mapped into memory where that's possible and read in
+// otherwise. Everything is parsed straight out of it, rather than seeking
+// around the file and reading it a byte at a time.
+class FileData
+{
+public:
+    FileData(const std::string &path, const std::string &displayPath)
+    {
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary);
 
-static std::uint32_t s_sectionHeaderOffset;
-static int s_sectionHeaderEntrySize;
-static int s_sectionCount;
-static int s_shstrtabIndex;
+        if (!file.is_open())
+            FATAL_ERROR("error: failed to open \"%s\" for reading\n", displayPath.c_str());
 
-static std::uint32_t s_symtabOffset;
-static std::uint32_t s_strtabOffset;
+        m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        m_data = reinterpret_cast<const unsigned char *>(m_buffer.data());
+        m_size = m_buffer.size();
+#else
+        int fd = open(path.c_str(), O_RDONLY);
 
-static std::uint32_t s_symbolCount;
-static std::uint32_t s_elfFileOffset;
+        if (fd < 0)
+            FATAL_ERROR("error: failed to open \"%s\" for reading\n", displayPath.c_str());
 
-struct Symbol
-{
-    std::uint32_t nameOffset;
-    std::uint32_t size;
-};
+        struct stat st;
 
-static void Seek(long offset)
-{
-    if (std::fseek(s_file, s_elfFileOffset + offset, SEEK_SET) != 0)
-        FATAL_ERROR("error: failed to seek to %ld in \"%s\"", offset, s_elfPath.c_str());
-}
+        if (fstat(fd, &st) != 0)
+            FATAL_ERROR("error: failed to get the size of \"%s\"\n", displayPath.c_str());
 
-static void Skip(long offset)
-{
-    if (std::fseek(s_file, offset, SEEK_CUR) != 0)
-        FATAL_ERROR("error: failed to skip %ld bytes in \"%s\"", offset, s_elfPath.c_str());
-}
+        m_size = st.st_size;
+        m_data = nullptr;
 
-static std::uint32_t ReadInt8()
-{
-    int c = std::fgetc(s_file);
+        // An empty file can't be mapped, but has nothing to read anyway.
+        if (m_size != 0)
+        {
+            void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
 
-    if (c < 0)
-        FATAL_ERROR("error: unexpected EOF when reading ELF file \"%s\"\n", s_elfPath.c_str());
+            if (data == MAP_FAILED)
+                FATAL_ERROR("error: failed to map \"%s\" into memory\n", displayPath.c_str());
+
+            m_data = static_cast<const unsigned char *>(data);
+        }
+
+        close(fd);
+#endif
+    }
+
+    ~FileData()
+    {
+#ifndef _WIN32
+        if (m_data != nullptr)
+            munmap(const_cast<unsigned char *>(m_data), m_size);
+#endif
+    }
+
+    FileData(const FileData &) = delete;
+    FileData &operator=(const FileData &) = delete;
+
+    const unsigned char *Data() const { return m_data; }
+    std::size_t Size() const { return m_size; }
+
+private:
+    const unsigned char *m_data;
+    std::size_t m_size;
+#ifdef _WIN32
+    std::vector<char> m_buffer;
+#endif
+};
+
+// The bytes of the ELF file being read, which are part of an archive when it
+// came from one.
+static const unsigned char *s_elf;
+static std::size_t s_elfSize;
 
-    return c;
+static void CheckRange(std::uint32_t offset, std::uint32_t length)
+{
+    if (offset > s_elfSize || length > s_elfSize - offset)
+        FATAL_ERROR("error: unexpected EOF when reading ELF file \"%s\"\n", s_elfPath.c_str());
 }
 
-static std::uint32_t ReadInt16()
+static std::uint32_t ReadInt16(std::uint32_t offset)
 {
-    std::uint32_t val = 0;
-    val |= ReadInt8();
-    val |= ReadInt8() << 8;
-    return val;
+    CheckRange(offset, 2);
+    const unsigned char *p = s_elf + offset;
+    return p[0] | (p[1] << 8);
 }
 
-static std::uint32_t ReadInt32()
+static std::uint32_t ReadInt32(std::uint32_t offset)
 {
-    std::uint32_t val = 0;
-    val |= ReadInt8();
-    val |= ReadInt8() << 8;
-    val |= ReadInt8() << 16;
-    val |= ReadInt8() << 24;
-    return val;
+    CheckRange(offset, 4);
+    const unsigned char *p = s_elf + offset;
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((std::uint32_t)p[3] << 24);
 }
 
-static std::string ReadString()
+// Returns the NUL-terminated string at offset, in place.
+static const char *ReadString(std::uint32_t offset)
 {
-    std::string s;
-    char c;
+    CheckRange(offset, 0);
+    const void *end = std::memchr(s_elf + offset, 0, s_elfSize - offset);
 
-    while ((c = ReadInt8()) != 0)
-        s += c;
+    if (end == nullptr)
+        FATAL_ERROR("error: unexpected EOF when reading ELF file \"%s\"\n", s_elfPath.c_str());
 
-    return s;
+    return reinterpret_cast<const char *>(s_elf + offset);
 }
 
 static void VerifyElfIdent()
 {
     char expectedMagic[4] = { 0x7F, 'E', 'L', 'F' };
-    char magic[4];
 
-    if (std::fread(magic, 4, 1, s_file) != 1)
+    if (s_elfSize < 4)
         FATAL_ERROR("error: failed to read ELF magic from \"%s\"\n", s_elfPath.c_str());
 
-    if (std::memcmp(magic, expectedMagic, 4) != 0)
+    if (std::memcmp(s_elf, expectedMagic, 4) != 0)
         FATAL_ERROR("error: ELF magic did not match in \"%s\"\n", s_elfPath.c_str());
 
-    if (std::fgetc(s_file) != 1)
+    if (s_elfSize < 5 || s_elf[4] != 1)
         FATAL_ERROR("error: \"%s\" not 32-bit ELF\n", s_elfPath.c_str());
 
-    if (std::fgetc(s_file) != 1)
+    if (s_elfSize < 6 || s_elf[5] != 1)
         FATAL_ERROR("error: \"%s\" not little-endian ELF\n", s_elfPath.c_str());
 }
 
-static void VerifyAr()
+static void VerifyAr(const FileData &archive)
 {
     char expectedMagic[8] = {'!', '<', 'a', 'r', 'c', 'h', '>', '\n'};
-    char magic[8];
 
-    if (std::fread(magic, 8, 1, s_file) != 1)
+    if (archive.Size() < 8)
         FATAL_ERROR("error: failed to read AR magic from \"%s\"\n", s_archiveFilePath.c_str());
 
-    if (std::memcmp(magic, expectedMagic, 8) != 0)
+    if (std::memcmp(archive.Data(), expectedMagic, 8) != 0)
         FATAL_ERROR("error: AR magic did not match in \"%s\"\n", s_archiveFilePath.c_str());
 }
 
-static void ReadElfHeader()
-{
-    Seek(0x20);
-    s_sectionHeaderOffset = ReadInt32();
-    Seek(0x2E);
-    s_sectionHeaderEntrySize = ReadInt16();
-    s_sectionCount = ReadInt16();
-    s_shstrtabIndex = ReadInt16();
-}
-
-static void FindArObj()
+// Points s_elf at the archive member named s_archiveObjectPath.
+static void FindArObj(const FileData &archive)
 {
-    char file_ident[17] = {0};
-    char filesize_s[11] = {0};
+    const unsigned char *data = archive.Data();
+    std::size_t size = archive.Size();
     char expectedEndMagic[2] = { 0x60, 0x0a };
-    char end_magic[2];
-    std::size_t filesize;
+    std::size_t pos = 8;
 
-    Seek(8);
-    while (!std::feof(s_file)) {
-        if (std::fread(file_ident, 16, 1, s_file) != 1)
+    while (pos < size) {
+        char file_ident[17] = {0};
+        char filesize_s[11] = {0};
+
+        if (size - pos < 16)
             FATAL_ERROR("error: failed to read file ident in \"%s\"\n", s_archiveFilePath.c_str());
-        Skip(32);
-        if (std::fread(filesize_s, 10, 1, s_file) != 1)
+        std::memcpy(file_ident, data + pos, 16);
+        if (size - pos < 58)
             FATAL_ERROR("error: failed to read filesize in \"%s\"\n", s_archiveFilePath.c_str());
-        if (std::fread(end_magic, 2, 1, s_file) != 1)
+        std::memcpy(filesize_s, data + pos + 48, 10);
+        if (size - pos < 60)
             FATAL_ERROR("error: failed to read end sentinel in \"%s\"\n", s_archiveFilePath.c_str());
-        if (std::memcmp(end_magic, expectedEndMagic, 2) != 0)
+        if (std::memcmp(data + pos + 58, expectedEndMagic, 2) != 0)
             FATAL_ERROR("error: corrupted archive header in \"%s\" at \"%s\"\n", s_archiveFilePath.c_str(), file_ident);
+        pos += 60;
 
         char * ptr = std::strchr(file_ident, '/');
         if (ptr != nullptr)
             *ptr = 0;
-        filesize = std::strtoul(filesize_s, nullptr, 10);
+        std::size_t filesize = std::strtoul(filesize_s, nullptr, 10);
+        if (filesize > size - pos)
+            filesize = size - pos;
         if (std::strncmp(s_archiveObjectPath.c_str(), file_ident, 16) == 0) {
-            s_elfFileOffset = std::ftell(s_file);
+            s_elf = data + pos;
+            s_elfSize = filesize;
             return;
         }
-        Skip(filesize);
+
+        // Members are padded to an even length.
+        pos += filesize + (filesize & 1);
     }
 
     FATAL_ERROR("error: could not find object \"%s\" in archive \"%s\"\n", s_archiveObjectPath.c_str(), s_archiveFilePath.c_str());
 }
 
-static std::string GetSectionName(std::uint32_t shstrtabOffset, int index)
+static std::map<std::string, std::uint32_t> GetCommonSymbols_Shared()
 {
-    Seek(s_sectionHeaderOffset + s_sectionHeaderEntrySize * index);
-    std::uint32_t nameOffset = ReadInt32();
-    Seek(shstrtabOffset + nameOffset);
-    return ReadString();
-}
+    VerifyElfIdent();
 
-static void FindTableOffsets()
-{
-    s_symtabOffset = 0;
-    s_strtabOffset = 0;
+    std::uint32_t sectionHeaderOffset = ReadInt32(0x20);
+    std::uint32_t sectionHeaderEntrySize = ReadInt16(0x2E);
+    std::uint32_t sectionCount = ReadInt16(0x30);
+    std::uint32_t shstrtabIndex = ReadInt16(0x32);
 
-    Seek(s_sectionHeaderOffset + s_sectionHeaderEntrySize * s_shstrtabIndex + 0x10);
-    std::uint32_t shstrtabOffset = ReadInt32();
+    std::uint32_t shstrtabOffset = ReadInt32(sectionHeaderOffset + sectionHeaderEntrySize * shstrtabIndex + 0x10);
 
-    for (int i = 0; i < s_sectionCount; i++)
+    std::uint32_t symtabOffset = 0;
+    std::uint32_t strtabOffset = 0;
+    std::uint32_t symbolCount = 0;
+
+    for (std::uint32_t i = 0; i < sectionCount; i++)
     {
-        std::string name = GetSectionName(shstrtabOffset, i);
+        std::uint32_t sectionHeader = sectionHeaderOffset + sectionHeaderEntrySize * i;
+        const char *name = ReadString(shstrtabOffset + ReadInt32(sectionHeader));
 
-        if (name == ".symtab")
+        if (std::strcmp(name, ".symtab") == 0)
         {
-            if (s_symtabOffset)
+            if (symtabOffset)
                 FATAL_ERROR("error: mutiple .symtab sections found in \"%s\"\n", s_elfPath.c_str());
-            Seek(s_sectionHeaderOffset + s_sectionHeaderEntrySize * i + 0x10);
-            s_symtabOffset = ReadInt32();
-            std::uint32_t size = ReadInt32();
-            s_symbolCount = size / 16;
+            symtabOffset = ReadInt32(sectionHeader + 0x10);
+            symbolCount = ReadInt32(sectionHeader + 0x14) / 16;
         }
-        else if (name == ".strtab")
+        else if (std::strcmp(name, ".strtab") == 0)
         {
-            if (s_strtabOffset)
+            if (strtabOffset)
                 FATAL_ERROR("error: mutiple .strtab sections found in \"%s\"\n", s_elfPath.c_str());
-            Seek(s_sectionHeaderOffset + s_sectionHeaderEntrySize * i + 0x10);
-            s_strtabOffset = ReadInt32();
+            strtabOffset = ReadInt32(sectionHeader + 0x10);
         }
     }
 
-    if (!s_symtabOffset)
+    if (!symtabOffset)
         FATAL_ERROR("error: couldn't find .symtab section in \"%s\"\n", s_elfPath.c_str());
 
-    if (!s_strtabOffset)
+    if (!strtabOffset)
         FATAL_ERROR("error: couldn't find .strtab section in \"%s\"\n", s_elfPath.c_str());
-}
 
-static std::map<std::string, std::uint32_t> GetCommonSymbols_Shared()
-{
-    VerifyElfIdent();
-    ReadElfHeader();
-    FindTableOffsets();
+    CheckRange(symtabOffset, symbolCount * 16);
 
     std::map<std::string, std::uint32_t> commonSymbols;
 
-    std::vector<Symbol> commonSymbolVec;
-
-    Seek(s_symtabOffset);
-
-    for (std::uint32_t i = 0; i < s_symbolCount; i++)
+    for (std::uint32_t i = 0; i < symbolCount; i++)
     {
-        Symbol sym;
-        sym.nameOffset = ReadInt32();
-        Skip(4);
-        sym.size = ReadInt32();
-        Skip(2);
-        std::uint16_t sectionIndex = ReadInt16();
-        if (sectionIndex == SHN_COMMON)
-            commonSymbolVec.push_back(sym);
-    }
+        std::uint32_t symbol = symtabOffset + 16 * i;
+        std::uint16_t sectionIndex = ReadInt16(symbol + 14);
 
-    for (const Symbol& sym : commonSymbolVec)
-    {
-        Seek(s_strtabOffset + sym.nameOffset);
-        std::string name = ReadString();
-        commonSymbols[name] = sym.size;
+        if (sectionIndex == SHN_COMMON)
+            commonSymbols[ReadString(strtabOffset + ReadInt32(symbol))] = ReadInt32(symbol + 8);
     }
 
     return commonSymbols;
@@ -246,27 +267,23 @@ std::map<std::string, std::uint32_t> GetCommonSymbolsFromLib(std::string sourceP
     s_archiveFilePath = sourcePath + "/" + libpath.substr(1, colonPos - 1);
     s_elfPath = sourcePath + "/" + libpath.substr(1);
 
-    s_file = std::fopen(s_archiveFilePath.c_str(), "rb");
-
-    if (s_file == NULL)
-        FATAL_ERROR("error: failed to open \"%s\" for reading\n", s_archiveFilePath.c_str());
+    FileData archive(s_archiveFilePath, s_archiveFilePath);
 
-    VerifyAr();
-    FindArObj();
+    VerifyAr(archive);
+    FindArObj(archive);
     return GetCommonSymbols_Shared();
 }
 
 std::map<std::string, std::uint32_t> GetCommonSymbols(std::string sourcePath, std::string path)
 {
-    s_elfFileOffset = 0;
     if (path[0] == '*')
         return GetCommonSymbolsFromLib(sourcePath, path);
 
     s_elfPath = sourcePath + "/" + path;
-    s_file = std::fopen(s_elfPath.c_str(), "rb");
 
-    if (s_file == NULL)
-        FATAL_ERROR("error: failed to open \"%s\" for reading\n", path.c_str());
+    FileData file(s_elfPath, path);
 
+    s_elf = file.Data();
+    s_elfSize = file.Size();
     return GetCommonSymbols_Shared();
 }